@@ -0,0 +1,78 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <sstream>
+
+#include "Generator.hpp"
+
+using std::ostream;
+using std::ostringstream;
+using std::string;
+using std::to_string;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function writes YAML data containing block mappings, block
+ *        sequences, scalars of every supported style and comments.
+ *
+ * @param output This parameter specifies the stream this function writes to.
+ * @param size This number specifies the minimum size of the written text in
+ *             bytes.
+ */
+void generateInput(ostream &output, size_t const size) {
+  size_t written = 0;
+  for (size_t index = 0; written < size; index++) {
+    string number = to_string(index);
+    string entry;
+    entry += "key" + number + ": plain value number " + number + "\n";
+    entry += "map" + number + ":\n";
+    entry += "  double: \"double quoted value " + number + "\"\n";
+    entry += "  single: 'single quoted value " + number + "'\n";
+    entry += "  # Comment " + number + "\n";
+    entry += "list" + number + ":\n";
+    entry += "  - first element\n";
+    entry += "  - second element # Comment\n";
+    output << entry;
+    written += entry.size();
+  }
+}
+
+/**
+ * @brief This function creates YAML data containing block mappings, block
+ *        sequences, scalars of every supported style and comments.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+string generateInput(size_t const size) {
+  ostringstream text;
+  generateInput(text, size);
+  return text.str();
+}
+
+/**
+ * @brief This function creates YAML data that maps keys to long base64
+ *        encoded values, such as certificates.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+string generateCertificates(size_t const size) {
+  string const alphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  string text;
+  for (size_t index = 0; text.size() < size; index++) {
+    string number = to_string(index);
+    string value;
+    for (size_t character = 0; character < 2048; character++) {
+      value += alphabet[(character * 7 + index) % alphabet.size()];
+    }
+    text += "certificate" + number + ": " + value + "==\n";
+    text += "signature" + number + ": \"" + value.substr(0, 512) + "\"\n";
+  }
+  return text;
+}
@@ -0,0 +1,43 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <ostream>
+#include <string>
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function writes YAML data containing block mappings, block
+ *        sequences, scalars of every supported style and comments.
+ *
+ * @param output This parameter specifies the stream this function writes to.
+ * @param size This number specifies the minimum size of the written text in
+ *             bytes.
+ */
+void generateInput(std::ostream &output, size_t const size);
+
+/**
+ * @brief This function creates YAML data containing block mappings, block
+ *        sequences, scalars of every supported style and comments.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+std::string generateInput(size_t const size);
+
+/**
+ * @brief This function creates YAML data that maps keys to long base64
+ *        encoded values, such as certificates.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+std::string generateCertificates(size_t const size);
+
+#endif // GENERATOR_HPP
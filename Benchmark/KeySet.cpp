@@ -0,0 +1,128 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <kdb.hpp>
+
+using std::cout;
+using std::endl;
+using std::stable_sort;
+using std::stoul;
+using std::string;
+using std::to_string;
+using std::vector;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates keys in the order `KeyListener` creates them.
+ *
+ * The keys belong to a mapping, where each value is a mapping that contains
+ * a scalar and a sequence. The keys of the top level mapping are not sorted,
+ * and the listener adds the parent of a sequence after its elements. The
+ * keys therefore arrive mostly, but not completely, out of order.
+ *
+ * @param size This number specifies the minimum number of keys the function
+ *             creates.
+ *
+ * @return A vector containing at least `size` keys
+ */
+vector<CppKey> generateKeys(size_t const size) {
+  size_t const elements = 8;
+  size_t const keysPerEntry = elements + 2;
+  size_t const entries = (size + keysPerEntry - 1) / keysPerEntry;
+
+  vector<CppKey> keys;
+  keys.reserve(entries * keysPerEntry);
+  for (size_t entry = 0; entry < entries; entry++) {
+    // Visit the entries in a scrambled order
+    string const parent =
+        "user/entry" + to_string(entry * 7919 % entries) + "/";
+    keys.push_back(CppKey{(parent + "name").c_str(), KEY_VALUE, "value",
+                          KEY_END});
+    for (size_t element = 0; element < elements; element++) {
+      keys.push_back(CppKey{(parent + "list/#" + to_string(element)).c_str(),
+                            KEY_VALUE, "element", KEY_END});
+    }
+    keys.push_back(CppKey{(parent + "list").c_str(), KEY_END});
+  }
+  return keys;
+}
+
+/**
+ * @brief This function adds keys to a key set one at a time.
+ *
+ * @param keys This parameter stores the keys this function adds.
+ *
+ * @return A key set containing `keys`
+ */
+CppKeySet buildIncremental(vector<CppKey> const &keys) {
+  CppKeySet keySet;
+  for (auto const &key : keys) {
+    keySet.append(key);
+  }
+  return keySet;
+}
+
+/**
+ * @brief This function sorts keys and then adds them to a key set with
+ *        preallocated capacity.
+ *
+ * @param keys This parameter stores the keys this function adds.
+ *
+ * @return A key set containing `keys`
+ */
+CppKeySet buildBulk(vector<CppKey> keys) {
+  stable_sort(keys.begin(), keys.end());
+  CppKeySet keySet{keys.size(), KS_END};
+  for (auto const &key : keys) {
+    keySet.append(key);
+  }
+  return keySet;
+}
+
+/**
+ * @brief This function measures the time a strategy needs to create a key
+ *        set.
+ *
+ * @param name This parameter stores the name of the strategy.
+ * @param build This parameter stores the function that creates the key set.
+ * @param keys This parameter stores the keys the strategy adds.
+ */
+template <typename Build>
+void measure(string const &name, Build build, vector<CppKey> const &keys) {
+  auto start = steady_clock::now();
+  CppKeySet keySet = build(keys);
+  duration<double> seconds = steady_clock::now() - start;
+  cout << "[" << name << "] Added " << keys.size() << " keys ("
+       << keySet.size() << " unique) in " << seconds.count() << " s" << endl;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * This program compares two strategies to create a key set: adding keys one
+ * by one in the order the listener creates them, and sorting all keys before
+ * adding them to a key set of the right capacity.
+ */
+int main(int argc, char const *argv[]) {
+  size_t size = 1000000;
+
+  if (argc > 1) {
+    size = stoul(argv[1]);
+  }
+
+  vector<CppKey> const keys = generateKeys(size);
+  measure("incremental", buildIncremental, keys);
+  measure("bulk", buildBulk, keys);
+}
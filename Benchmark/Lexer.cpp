@@ -0,0 +1,107 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+
+#include <antlr4-runtime.h>
+
+#include "../Source/YAMLLexer.hpp"
+#include "Generator.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::shared_ptr;
+using std::stoul;
+using std::string;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+using antlr4::ANTLRInputStream;
+using antlr4::CharStream;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function retrieves all tokens produced by the given lexer.
+ *
+ * @param lexer This parameter stores the lexer this function exhausts.
+ *
+ * @return The number of tokens (excluding `EOF`) produced by `lexer`
+ */
+size_t countTokens(TokenSource &lexer) {
+  size_t tokens = 0;
+  while (lexer.nextToken()->getType() != Token::EOF) {
+    tokens++;
+  }
+  return tokens;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t megabytes = 10;
+  bool trace = false;
+  bool generic = true;
+  bool certificates = false;
+  Kernels kernels = Kernels::AVX2;
+
+  for (int argument = 1; argument < argc; argument++) {
+    if (string(argv[argument]) == "--trace") {
+      trace = true;
+    } else if (string(argv[argument]) == "--lexer=generic") {
+      generic = true;
+    } else if (string(argv[argument]) == "--lexer=buffer") {
+      generic = false;
+    } else if (string(argv[argument]) == "--input=mixed") {
+      certificates = false;
+    } else if (string(argv[argument]) == "--input=certificates") {
+      certificates = true;
+    } else if (string(argv[argument]) == "--kernels=scalar") {
+      kernels = Kernels::SCALAR;
+    } else if (string(argv[argument]) == "--kernels=sse2") {
+      kernels = Kernels::SSE2;
+    } else if (string(argv[argument]) == "--kernels=avx2") {
+      kernels = Kernels::AVX2;
+    } else {
+      megabytes = stoul(argv[argument]);
+    }
+  }
+
+  shared_ptr<logger> console;
+  if (trace) {
+#ifdef HAVE_TRACE
+    console = createTraceLogger();
+#else
+    cerr << "Trace messages are disabled in this build" << endl;
+    return EXIT_FAILURE;
+#endif
+  }
+
+  kernels = useKernels(kernels);
+
+  size_t const size = megabytes * 1024 * 1024;
+  string text =
+      certificates ? generateCertificates(size) : generateInput(size);
+  ANTLRInputStream genericInput{generic ? text : ""};
+  BufferStream bufferInput{text.data(), text.size()};
+
+  auto start = steady_clock::now();
+  size_t tokens = 0;
+  if (generic) {
+    YAMLLexer<CharStream> lexer{&genericInput, console};
+    tokens = countTokens(lexer);
+  } else {
+    YAMLLexer<BufferStream> lexer{&bufferInput, console};
+    tokens = countTokens(lexer);
+  }
+  duration<double> seconds = steady_clock::now() - start;
+
+  double mebibytes = text.size() / (1024.0 * 1024.0);
+  if (!generic) {
+    cout << "[" << kernelName(kernels) << "] ";
+  }
+  cout << "Lexed " << tokens << " tokens (" << mebibytes << " MiB) in "
+       << seconds.count() << " s: " << mebibytes / seconds.count() << " MiB/s"
+       << endl;
+}
@@ -0,0 +1,177 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <antlr4-runtime.h>
+#include <kdb.hpp>
+
+#include "../Source/BufferStream.hpp"
+#include "../Source/ChunkParser.hpp"
+#include "../Source/InputBuffer.hpp"
+#include "Generator.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::ofstream;
+using std::stoul;
+using std::string;
+using std::stringstream;
+
+using antlr4::ANTLRInputStream;
+using antlr4::CharStream;
+using antlr4::Token;
+
+using ckdb::keyNew;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function reads all characters of the given stream.
+ *
+ * The lexer stores all of its tokens in an arena, which it only frees at the
+ * end of the parsing process. To measure only the memory used by the input,
+ * we therefore do not lex the data, but read it character by character.
+ *
+ * @param input This parameter stores the stream this function exhausts.
+ *
+ * @return The number of lines in `input`
+ */
+size_t countLines(CharStream &input) {
+  size_t lines = 0;
+  for (size_t character = input.LA(1); character != Token::EOF;
+       character = input.LA(1)) {
+    if (character == '\n') {
+      lines++;
+    }
+    input.consume();
+  }
+  return lines;
+}
+
+/**
+ * @brief This function reads a file the way `badger` did before it supported
+ *        memory mapped input.
+ *
+ * @param filename This parameter specifies the location of the input file.
+ *
+ * @return The number of lines in the file
+ */
+size_t readStream(string const &filename) {
+  ifstream file{filename};
+  stringstream text;
+  text << file.rdbuf();
+  // `badger` copied the text once for the echo of the input…
+  cout << "Read " << text.str().size() << " bytes" << endl;
+  // …and once more for the input stream of the lexer
+  ANTLRInputStream input{text.str()};
+  return countLines(input);
+}
+
+/**
+ * @brief This function maps a file into memory and reads the mapped data.
+ *
+ * @param filename This parameter specifies the location of the input file.
+ *
+ * @return The number of lines in the file
+ */
+size_t readMapping(string const &filename) {
+  InputBuffer content{filename};
+  cout << "Read " << content.size() << " bytes" << endl;
+  BufferStream input{content.begin(), content.size(), filename};
+  return countLines(input);
+}
+
+/**
+ * @brief This function converts a file to keys, reading the file in chunks.
+ *
+ * Unlike the other functions, this function does not only read the input, but
+ * also lexes and parses it. It only counts the keys the parser produces, so
+ * the peak memory usage shows the cost of the whole chunked parsing process.
+ *
+ * @param filename This parameter specifies the location of the input file.
+ *
+ * @return The number of keys in the file
+ */
+size_t parseChunks(string const &filename) {
+  ifstream file{filename, std::ios::binary};
+  ChunkStream input{file, 64 * 1024, filename};
+  ChunkParser parser;
+  CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+  size_t keys = 0;
+  parser.parse(&input, parent,
+               [&keys](CppKeySet &batch) { keys += batch.size(); });
+  return keys;
+}
+
+/**
+ * @brief This function determines the maximum resident set size of the
+ *        current process.
+ *
+ * @return The peak resident set size in mebibytes
+ */
+double peakResidentSetSize() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024.0 * 1024.0); // macOS reports bytes
+#else
+  return usage.ru_maxrss / 1024.0; // Linux reports kibibytes
+#endif
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t megabytes = 500;
+  bool map = true;
+  bool chunked = false;
+
+  for (int argument = 1; argument < argc; argument++) {
+    if (string(argv[argument]) == "--input=stream") {
+      map = false;
+      chunked = false;
+    } else if (string(argv[argument]) == "--input=map") {
+      map = true;
+      chunked = false;
+    } else if (string(argv[argument]) == "--input=chunked") {
+      map = false;
+      chunked = true;
+    } else {
+      megabytes = stoul(argv[argument]);
+    }
+  }
+
+  char location[] = "/tmp/badger-benchmark-XXXXXX";
+  int descriptor = mkstemp(location);
+  if (descriptor < 0) {
+    cerr << "Unable to create temporary file" << endl;
+    return EXIT_FAILURE;
+  }
+  close(descriptor);
+  string const filename{location};
+
+  {
+    ofstream file{filename};
+    generateInput(file, megabytes * 1024 * 1024);
+  }
+  double const baseline = peakResidentSetSize();
+
+  if (chunked) {
+    size_t const keys = parseChunks(filename);
+    std::remove(location);
+    cout << "Parsed " << keys << " keys" << endl;
+  } else {
+    size_t lines = map ? readMapping(filename) : readStream(filename);
+    std::remove(location);
+    cout << "Read " << lines << " lines" << endl;
+  }
+  cout << "Peak RSS: " << peakResidentSetSize() << " MiB (" << baseline
+       << " MiB before reading the input)" << endl;
+}
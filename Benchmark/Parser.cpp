@@ -0,0 +1,208 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+
+#include <antlr4-runtime.h>
+
+#include "YAML.h"
+#include "YAMLBaseListener.h"
+
+#include "../Source/EventParser.hpp"
+#include "../Source/TokenPipeline.hpp"
+#include "../Source/TwoStageParser.hpp"
+#include "../Source/YAMLLexer.hpp"
+#include "Generator.hpp"
+
+using std::cout;
+using std::endl;
+using std::stoul;
+using std::string;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+using antlr4::BaseErrorListener;
+using antlr4::CommonTokenStream;
+using ParseTreeWalker = antlr4::tree::ParseTreeWalker;
+
+using antlr::YAML;
+using antlr::YAMLBaseListener;
+
+// -- Classes ------------------------------------------------------------------
+
+/**
+ * @brief This class counts the callbacks of the ANTLR parse tree walker, that
+ *        `KeyListener` relies on.
+ *
+ * Like `KeyListener`, the class retrieves the text of values and keys from
+ * the rule contexts.
+ */
+class TreeCounter : public YAMLBaseListener {
+public:
+  /** This variable stores the number of callbacks. */
+  size_t events = 0;
+
+  /** This variable stores the number of characters in keys and values. */
+  size_t characters = 0;
+
+  void exitValue(YAML::ValueContext *context) override {
+    characters += context->getText().size();
+    events++;
+  }
+  void enterPair(YAML::PairContext *context) override {
+    characters += context->key()->getText().size();
+    events++;
+  }
+  void exitPair(YAML::PairContext *context __attribute__((unused))) override {
+    events++;
+  }
+  void enterSequence(YAML::SequenceContext *context
+                     __attribute__((unused))) override {
+    events++;
+  }
+  void exitSequence(YAML::SequenceContext *context
+                    __attribute__((unused))) override {
+    events++;
+  }
+  void enterElement(YAML::ElementContext *context
+                    __attribute__((unused))) override {
+    events++;
+  }
+  void exitElement(YAML::ElementContext *context
+                   __attribute__((unused))) override {
+    events++;
+  }
+};
+
+/**
+ * @brief This class counts the callbacks of the event parser.
+ */
+class EventCounter : public EventListener {
+public:
+  /** This variable stores the number of callbacks. */
+  size_t events = 0;
+
+  /** This variable stores the number of characters in keys and values. */
+  size_t characters = 0;
+
+  void enterDocument() override { events++; }
+  void exitDocument() override { events++; }
+  void exitValue(ScalarView const &text) override {
+    characters += text.size();
+    events++;
+  }
+  void enterPair(ScalarView const &key,
+                 bool const hasValue __attribute__((unused))) override {
+    characters += key.size();
+    events++;
+  }
+  void exitPair() override { events++; }
+  void enterSequence() override { events++; }
+  void exitSequence() override { events++; }
+  void enterElement() override { events++; }
+  void exitElement() override { events++; }
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function parses the given text with the ANTLR parser and walks
+ *        the resulting parse tree.
+ *
+ * @param text This parameter stores the YAML data this function parses.
+ * @param twoStage This boolean specifies if the parser should use two-stage
+ *                 (SLL, then LL) prediction instead of full LL prediction.
+ * @param pipelined This boolean specifies if the lexer runs on a thread of its
+ *                  own.
+ *
+ * @return The number of listener callbacks
+ */
+size_t parseTree(string const &text, bool const twoStage,
+                 bool const pipelined) {
+  BufferStream input{text.data(), text.size()};
+  YAMLLexer<BufferStream> lexer{&input};
+  TokenPipeline<BufferStream> pipeline;
+  TokenSource *source = &lexer;
+  if (pipelined) {
+    pipeline.start(&lexer);
+    source = &pipeline;
+  }
+  CommonTokenStream tokens{source};
+  YAML parser{&tokens};
+
+  BaseErrorListener errorListener;
+  ParseTree *tree =
+      twoStage
+          ? parseTwoStage(parser, tokens, errorListener, nullptr, !pipelined)
+          : parser.yaml();
+
+  TreeCounter counter;
+  ParseTreeWalker walker{};
+  walker.walk(&counter, tree);
+  return counter.events;
+}
+
+/**
+ * @brief This function parses the given text with the event parser.
+ *
+ * @param text This parameter stores the YAML data this function parses.
+ * @param pipelined This boolean specifies if the lexer runs on a thread of its
+ *                  own.
+ *
+ * @return The number of listener callbacks
+ */
+size_t parseEvents(string const &text, bool const pipelined) {
+  BufferStream input{text.data(), text.size()};
+  YAMLLexer<BufferStream> lexer{&input};
+  TokenPipeline<BufferStream> pipeline;
+  TokenSource *source = &lexer;
+  if (pipelined) {
+    pipeline.start(&lexer);
+    source = &pipeline;
+  }
+  EventParser parser{source, text.data()};
+
+  EventCounter counter;
+  parser.parse(counter);
+  return counter.events;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t megabytes = 10;
+  bool events = true;
+  bool twoStage = false;
+  bool pipelined = false;
+
+  for (int argument = 1; argument < argc; argument++) {
+    if (string(argv[argument]) == "--parser=antlr") {
+      events = false;
+    } else if (string(argv[argument]) == "--parser=event") {
+      events = true;
+    } else if (string(argv[argument]) == "--prediction=two-stage") {
+      twoStage = true;
+    } else if (string(argv[argument]) == "--prediction=ll") {
+      twoStage = false;
+    } else if (string(argv[argument]) == "--pipeline=none") {
+      pipelined = false;
+    } else if (string(argv[argument]) == "--pipeline=lexer") {
+      pipelined = true;
+    } else {
+      megabytes = stoul(argv[argument]);
+    }
+  }
+
+  string text = generateInput(megabytes * 1024 * 1024);
+
+  auto start = steady_clock::now();
+  size_t const callbacks = events ? parseEvents(text, pipelined)
+                                  : parseTree(text, twoStage, pipelined);
+  duration<double> seconds = steady_clock::now() - start;
+
+  double mebibytes = text.size() / (1024.0 * 1024.0);
+  cout << "[" << (events ? "event" : twoStage ? "antlr, SLL/LL" : "antlr, LL")
+       << (pipelined ? ", lexer thread" : "") << "] Parsed " << callbacks
+       << " events (" << mebibytes << " MiB) in " << seconds.count()
+       << " s: " << mebibytes / seconds.count() << " MiB/s" << endl;
+}
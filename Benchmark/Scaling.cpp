@@ -0,0 +1,148 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <antlr4-runtime.h>
+
+#include "../Source/YAMLLexer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::function;
+using std::max;
+using std::min;
+using std::pair;
+using std::stoul;
+using std::string;
+using std::vector;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a mapping that contains a single key, which
+ *        consists of many words.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+string generateLongKey(size_t const size) {
+  string text;
+  while (text.size() < size) {
+    text += "word ";
+  }
+  return text + "end: value\n";
+}
+
+/**
+ * @brief This function creates a mapping, where a long block sequence follows
+ *        a key.
+ *
+ * The last scalar of the sequence stays a simple key candidate until the
+ * lexer finds the next key. The lexer therefore holds back all tokens of the
+ * sequence.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+string generateLongSequence(size_t const size) {
+  string text = "list:\n";
+  while (text.size() < size) {
+    text += "  - element\n";
+  }
+  return text + "key: value\n";
+}
+
+/**
+ * @brief This function creates a mapping, where a long run of comments
+ *        follows the first value.
+ *
+ * The value stays a simple key candidate until the lexer finds the next key.
+ * The lexer therefore holds back all comment tokens.
+ *
+ * @param size This number specifies the minimum size of the returned text in
+ *             bytes.
+ *
+ * @return A YAML document that is at least `size` bytes long
+ */
+string generateLongComments(size_t const size) {
+  string text = "key: value\n";
+  while (text.size() < size) {
+    text += "# comment\n";
+  }
+  return text + "other: value\n";
+}
+
+/**
+ * @brief This function measures the throughput of the buffer lexer.
+ *
+ * @param text This parameter stores the data the lexer scans.
+ *
+ * @return The number of mebibytes per second the lexer processed
+ */
+double measure(string const &text) {
+  BufferStream input{text.data(), text.size()};
+  auto start = steady_clock::now();
+  {
+    YAMLLexer<BufferStream> lexer{&input};
+    while (lexer.nextToken()->getType() != Token::EOF) {
+    }
+  }
+  duration<double> seconds = steady_clock::now() - start;
+  return text.size() / (1024.0 * 1024.0) / seconds.count();
+}
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * This program checks that the time the lexer needs grows linearly with the
+ * length of simple key candidates. For each kind of input it doubles the
+ * input size a few times. If the lexer scales linearly, then the throughput
+ * stays (roughly) the same. The program fails, if the throughput for the
+ * largest input drops considerably compared to the smallest input.
+ */
+int main(int argc, char const *argv[]) {
+  size_t megabytes = 1;
+  size_t const doublings = 4;
+  double const tolerance = 3;
+
+  if (argc > 1) {
+    megabytes = stoul(argv[1]);
+  }
+
+  vector<pair<string, function<string(size_t)>>> generators{
+      {"Long key", generateLongKey},
+      {"Long sequence", generateLongSequence},
+      {"Long comment run", generateLongComments}};
+
+  bool linear = true;
+  for (auto const &generator : generators) {
+    double fastest = 0;
+    double slowest = 0;
+    cout << generator.first << ":";
+    for (size_t step = 0; step <= doublings; step++) {
+      size_t size = (megabytes * 1024 * 1024) << step;
+      double throughput = measure(generator.second(size));
+      cout << " " << (size >> 20) << " MiB: " << throughput << " MiB/s";
+      fastest = step == 0 ? throughput : max(fastest, throughput);
+      slowest = step == 0 ? throughput : min(slowest, throughput);
+    }
+    cout << endl;
+    if (fastest / slowest > tolerance) {
+      cerr << generator.first << ": Throughput dropped from " << fastest
+           << " MiB/s to " << slowest << " MiB/s" << endl;
+      linear = false;
+    }
+  }
+
+  return linear ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <kdb.hpp>
+
+#include "../Source/DocumentParser.hpp"
+#include "Generator.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::stoul;
+using std::string;
+using std::vector;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+using ckdb::keyNew;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function converts keys to text.
+ *
+ * @param keys This parameter stores the keys this function converts.
+ *
+ * @return The name and value of each key in `keys`
+ */
+string formatKeys(CppKeySet &keys) {
+  string text;
+  for (auto key : keys) {
+    text += key.getName() + ":" +
+            (key.getStringSize() > 1 ? " " + key.getString() : "") + "\n";
+  }
+  return text;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * This program measures how the throughput of a speculative document parser
+ * grows with the number of worker threads. The input is a single document
+ * with a large block mapping, so the parser splits the document in front of
+ * top level keys. The program prints the throughput and the speedup compared
+ * to a single worker for each number of threads. It fails, if the result of
+ * the document parser differs from the result of a single parser session.
+ */
+int main(int argc, char const *argv[]) {
+  size_t megabytes = 16;
+  Strategy strategy = Strategy::EVENT;
+
+  for (int argument = 1; argument < argc; argument++) {
+    if (string(argv[argument]) == "--parser=antlr") {
+      strategy = Strategy::TREE;
+    } else if (string(argv[argument]) == "--parser=event") {
+      strategy = Strategy::EVENT;
+    } else {
+      megabytes = stoul(argv[argument]);
+    }
+  }
+
+  string const text = generateInput(megabytes * 1024 * 1024);
+  double const mebibytes = text.size() / (1024.0 * 1024.0);
+  CppKey const parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+
+  string expected;
+  {
+    BufferStream input{text.data(), text.size()};
+    Parser<BufferStream> parser{strategy};
+    CppKeySet keys = parser.parse(&input, parent);
+    expected = formatKeys(keys);
+  }
+
+  bool correct = true;
+  double single = 0;
+  for (size_t const threads : vector<size_t>{1, 2, 4, 8, 16}) {
+    BufferStream input{text.data(), text.size()};
+    DocumentParser parser{threads, strategy, Prediction::TWO_STAGE,
+                          Speculation::KEYS};
+
+    auto start = steady_clock::now();
+    CppKeySet keys = parser.parse(&input, parent);
+    duration<double> seconds = steady_clock::now() - start;
+
+    double const throughput = mebibytes / seconds.count();
+    single = threads == 1 ? throughput : single;
+    cout << threads << (threads == 1 ? " thread: " : " threads: ")
+         << throughput << " MiB/s (speedup " << throughput / single << ")"
+         << endl;
+
+    if (formatKeys(keys) != expected) {
+      cerr << threads << " threads: Result differs from the result of a "
+           << "single parser session" << endl;
+      correct = false;
+    }
+  }
+
+  return correct ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,7 +4,11 @@ options {
   tokenVocab=YAML;
 }
 
-yaml : STREAM_START child? comment* STREAM_END EOF ;
+yaml : STREAM_START comment* bareDocument? (explicitDocument | documentEnd)*
+       STREAM_END EOF ;
+bareDocument : child ;
+explicitDocument : DOCUMENT_START child? comment* ;
+documentEnd : DOCUMENT_END comment* bareDocument? ;
 child : comment* (value | map | sequence) comment*;
 
 value : scalar ;
@@ -0,0 +1,67 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+
+#include "Arena.hpp"
+
+using std::max;
+using std::memcpy;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new empty arena.
+ *
+ * @param size This number specifies the default size of a memory block in
+ *             bytes.
+ */
+Arena::Arena(size_t const size) : blockSize{size} {}
+
+/**
+ * @brief This method copies a string into the arena.
+ *
+ * @param text This parameter stores the string this function copies.
+ *
+ * @return A pointer to a null terminated copy of `text`
+ */
+char const *Arena::copy(string const &text) {
+  char *memory = static_cast<char *>(allocate(text.size() + 1, 1));
+  memcpy(memory, text.c_str(), text.size() + 1);
+  return memory;
+}
+
+/**
+ * @brief This method releases all allocations of the arena.
+ *
+ * The arena keeps its current block and reuses it for new allocations. Memory
+ * returned by the arena before the call becomes invalid.
+ */
+void Arena::reset() {
+  if (blocks.empty()) {
+    return;
+  }
+  // We only know the size of the current block, so we keep this one
+  unique_ptr<char[]> current = move(blocks.back());
+  blocks.clear();
+  blocks.push_back(move(current));
+  position = blocks.back().get();
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method adds a new block that is large enough to store the given
+ *        number of bytes.
+ *
+ * @param size This number specifies the minimum number of bytes the new block
+ *             has to provide.
+ */
+void Arena::grow(size_t const size) {
+  size_t const length = max(size, blockSize);
+  blocks.emplace_back(new char[length]);
+  position = blocks.back().get();
+  end = position + length;
+}
@@ -0,0 +1,107 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using std::max_align_t;
+using std::string;
+using std::uintptr_t;
+using std::unique_ptr;
+using std::vector;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides a bump allocator.
+ *
+ * The arena hands out memory from large blocks. It never frees single
+ * allocations: The destructor of the arena releases all blocks at once.
+ */
+class Arena {
+  /** This vector stores all memory blocks allocated by the arena. */
+  vector<unique_ptr<char[]>> blocks;
+
+  /** This pointer stores the start of the free memory in the current block. */
+  char *position = nullptr;
+
+  /** This pointer stores the end of the current block. */
+  char *end = nullptr;
+
+  /** This number specifies the default size of a memory block in bytes. */
+  size_t const blockSize;
+
+  /**
+   * @brief This method adds a new block that is large enough to store the
+   *        given number of bytes.
+   *
+   * @param size This number specifies the minimum number of bytes the new
+   *             block has to provide.
+   */
+  void grow(size_t const size);
+
+public:
+  /**
+   * @brief This constructor creates a new empty arena.
+   *
+   * @param size This number specifies the default size of a memory block in
+   *             bytes.
+   */
+  Arena(size_t const size = 64 * 1024);
+
+  Arena(Arena const &) = delete;
+  Arena &operator=(Arena const &) = delete;
+
+  /**
+   * @brief This method allocates memory from the arena.
+   *
+   * @param size This number specifies the number of bytes this function
+   *             allocates.
+   * @param alignment This number specifies the alignment of the returned
+   *                  memory. The value has to be a power of two.
+   *
+   * @return A pointer to memory that stays valid as long as the arena exists
+   */
+  void *allocate(size_t const size,
+                 size_t const alignment = alignof(max_align_t));
+
+  /**
+   * @brief This method copies a string into the arena.
+   *
+   * @param text This parameter stores the string this function copies.
+   *
+   * @return A pointer to a null terminated copy of `text`
+   */
+  char const *copy(string const &text);
+
+  /**
+   * @brief This method releases all allocations of the arena.
+   *
+   * The arena keeps its current block and reuses it for new allocations.
+   * Memory returned by the arena before the call becomes invalid.
+   */
+  void reset();
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline void *Arena::allocate(size_t const size, size_t const alignment) {
+  uintptr_t address = reinterpret_cast<uintptr_t>(position);
+  size_t padding = (alignment - address % alignment) % alignment;
+  if (position == nullptr ||
+      static_cast<size_t>(end - position) < padding + size) {
+    grow(size + alignment);
+    address = reinterpret_cast<uintptr_t>(position);
+    padding = (alignment - address % alignment) % alignment;
+  }
+  char *memory = position + padding;
+  position = memory + size;
+  return memory;
+}
+
+#endif // ARENA_HPP
@@ -0,0 +1,336 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <kdb.hpp>
+
+#include "Batch.hpp"
+#include "BufferStream.hpp"
+#include "InputBuffer.hpp"
+#include "ThreadPool.hpp"
+
+using std::endl;
+using std::generic_category;
+using std::lock_guard;
+using std::min;
+using std::mutex;
+using std::ostringstream;
+using std::sort;
+using std::system_error;
+using std::unique_ptr;
+
+using ckdb::keyNew;
+
+// -- Types --------------------------------------------------------------------
+
+namespace {
+
+/** This structure stores the output of a single file. */
+struct Result {
+  /** This variable specifies if the file is already parsed. */
+  bool done = false;
+
+  /** This variable specifies if reading or parsing the file failed. */
+  bool failed = false;
+
+  /** This variable stores the keys of the file in text form. */
+  string keys;
+
+  /** This variable stores the error messages for the file. */
+  string errors;
+};
+
+/**
+ * @brief This class writes the results of multiple files in a fixed order.
+ *
+ * The class keeps the result of a file, until it wrote the results of all
+ * previous files.
+ */
+class OrderedOutput {
+  /** This variable protects all other variables against concurrent access. */
+  mutex lock;
+
+  /** This variable stores the results that are not written yet. */
+  vector<Result> results;
+
+  /** This variable stores the index of the next result this class writes. */
+  size_t next = 0;
+
+  /** This variable stores the number of failed files. */
+  size_t failures = 0;
+
+  /** This variable stores the stream that receives the keys. */
+  ostream &keyOutput;
+
+  /** This variable stores the stream that receives the error messages. */
+  ostream &errorOutput;
+
+public:
+  /**
+   * @brief This constructor creates a writer for the given number of files.
+   *
+   * @param files This number specifies the number of files.
+   * @param keyStream This parameter stores the stream that receives the keys.
+   * @param errorStream This parameter stores the stream that receives the
+   *                    error messages.
+   */
+  OrderedOutput(size_t const files, ostream &keyStream, ostream &errorStream)
+      : results(files), keyOutput(keyStream), errorOutput(errorStream) {}
+
+  /**
+   * @brief This method adds the result of a file, and writes all results
+   *        that do not wait for a previous result anymore.
+   *
+   * @param index This number specifies the position of the file.
+   * @param result This parameter stores the result of the file.
+   */
+  void add(size_t const index, Result &&result) {
+    lock_guard<mutex> guard{lock};
+    results[index] = std::move(result);
+    results[index].done = true;
+
+    for (; next < results.size() && results[next].done; next++) {
+      Result &current = results[next];
+      keyOutput << current.keys;
+      errorOutput << current.errors;
+      failures += current.failed ? 1 : 0;
+      // Release the memory of the result
+      current = Result{};
+      current.done = true;
+    }
+  }
+
+  /**
+   * @brief This method returns the number of failed files.
+   *
+   * @return The number of files the workers were unable to read or parse
+   */
+  size_t getFailures() {
+    lock_guard<mutex> guard{lock};
+    return failures;
+  }
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function checks if a filename uses the extension of YAML files.
+ *
+ * @param filename This parameter stores the filename this function checks.
+ *
+ * @retval true If `filename` ends with `.yaml` or `.yml`
+ *         false Otherwise
+ */
+bool isYAMLFile(string const &filename) {
+  for (string const extension : {".yaml", ".yml"}) {
+    if (filename.size() > extension.size() &&
+        filename.compare(filename.size() - extension.size(), extension.size(),
+                         extension) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief This function adds the YAML files inside a directory and its
+ *        subdirectories to a list.
+ *
+ * The function does not follow symbolic links to directories. This way it
+ * can not run into a cycle.
+ *
+ * @param directory This parameter stores the path of the directory.
+ * @param filenames This parameter stores the list this function adds the
+ *                  files to.
+ *
+ * @throws std::system_error If the function is unable to read a directory
+ */
+void collectFiles(string const &directory, vector<string> &filenames) {
+  unique_ptr<DIR, int (*)(DIR *)> stream{opendir(directory.c_str()),
+                                         closedir};
+  if (!stream) {
+    throw system_error(errno, generic_category(),
+                       "Unable to open directory “" + directory + "”");
+  }
+
+  while (dirent const *entry = readdir(stream.get())) {
+    string const name{entry->d_name};
+    if (name == "." || name == "..") {
+      continue;
+    }
+
+    string const path = directory + "/" + name;
+    struct stat status;
+    if (lstat(path.c_str(), &status) != 0) {
+      continue;
+    }
+    if (S_ISDIR(status.st_mode)) {
+      collectFiles(path, filenames);
+    } else if (isYAMLFile(name) && stat(path.c_str(), &status) == 0 &&
+               S_ISREG(status.st_mode)) {
+      filenames.push_back(path);
+    }
+  }
+}
+
+/**
+ * @brief This function converts keys to text.
+ *
+ * @param filename This parameter stores the name of the file that contains
+ *                 the keys.
+ * @param keys This parameter stores the keys this function converts.
+ *
+ * @return A header containing `filename`, followed by the name and value of
+ *         each key
+ */
+string formatKeys(string const &filename, CppKeySet &keys) {
+  ostringstream text;
+  text << "— " << filename << " ————" << endl << endl;
+  for (auto key : keys) {
+    text << key.getName() << ":"
+         << (key.getStringSize() > 1 ? " " + key.getString() : "") << endl;
+  }
+  text << endl;
+  return text.str();
+}
+
+/**
+ * @brief This function adds the name of a file in front of each line of
+ *        error messages.
+ *
+ * @param filename This parameter stores the name of the file.
+ * @param messages This parameter stores the error messages for the file.
+ *
+ * @return The error messages, where each line starts with `filename`
+ */
+string prefixLines(string const &filename, string const &messages) {
+  string text;
+  size_t start = 0;
+  while (start < messages.size()) {
+    size_t end = messages.find('\n', start);
+    end = end == string::npos ? messages.size() : end + 1;
+    text += filename + ":" + messages.substr(start, end - start);
+    start = end;
+  }
+  return text;
+}
+
+/**
+ * @brief This function parses a single file.
+ *
+ * @param parser This parameter stores the session that parses the file.
+ * @param messages This parameter stores the error stream of `parser`.
+ * @param filename This parameter stores the name of the file.
+ *
+ * @return The result of parsing the file
+ */
+Result parseFile(Parser<BufferStream> &parser, ostringstream &messages,
+                 string const &filename) {
+  Result result;
+  messages.str("");
+  try {
+    InputBuffer content{filename};
+    BufferStream input{content.begin(), content.size(), filename};
+    CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+    CppKeySet keys = parser.parse(&input, parent);
+    result.failed = parser.getNumberOfSyntaxErrors() > 0;
+    result.keys = formatKeys(filename, keys);
+    result.errors = prefixLines(filename, messages.str());
+  } catch (system_error const &error) {
+    result.failed = true;
+    result.errors = string{error.what()} + "\n";
+  }
+  return result;
+}
+
+} // namespace
+
+/**
+ * @brief This function checks if the given path specifies a directory.
+ *
+ * @param path This parameter stores the path this function checks.
+ *
+ * @retval true If `path` specifies a directory
+ *         false Otherwise
+ */
+bool isDirectory(string const &path) {
+  struct stat status;
+  return stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+/**
+ * @brief This function determines the files specified by the given paths.
+ *
+ * @param paths This parameter stores the paths of files and directories.
+ *
+ * @return The names of all files specified by `paths`
+ *
+ * @throws std::system_error If the function is unable to read a directory
+ */
+vector<string> listFiles(vector<string> const &paths) {
+  vector<string> filenames;
+  for (auto const &path : paths) {
+    if (!isDirectory(path)) {
+      filenames.push_back(path);
+      continue;
+    }
+    size_t const first = filenames.size();
+    collectFiles(path, filenames);
+    // The order of directory entries depends on the file system
+    sort(filenames.begin() + first, filenames.end());
+  }
+  return filenames;
+}
+
+/**
+ * @brief This function parses multiple files in parallel.
+ *
+ * @param filenames This parameter stores the names of the files this function
+ *                  parses.
+ * @param threads This number specifies the number of worker threads. The
+ *                value `0` specifies one worker per hardware thread.
+ * @param strategy This parameter specifies how the parser sessions turn
+ *                 tokens into keys.
+ * @param prediction This parameter specifies the prediction mode of the ANTLR
+ *                   parsers.
+ * @param console This parameter stores the logger that receives the trace
+ *                messages of the lexers, or `nullptr`.
+ * @param output This parameter stores the stream that receives the keys of
+ *               all files.
+ * @param errors This parameter stores the stream that receives the error
+ *               messages of all files.
+ *
+ * @return The number of files this function was unable to read or parse
+ */
+size_t parseFiles(vector<string> const &filenames, size_t const threads,
+                  Strategy const strategy, Prediction const prediction,
+                  shared_ptr<logger> const &console, ostream &output,
+                  ostream &errors) {
+  size_t const workers =
+      min(threads == 0 ? hardwareThreads() : threads,
+          filenames.empty() ? size_t{1} : filenames.size());
+
+  // Each worker reuses its parser session for all of its files
+  vector<unique_ptr<Parser<BufferStream>>> parsers;
+  vector<ostringstream> messages(workers);
+  for (size_t worker = 0; worker < workers; worker++) {
+    parsers.emplace_back(
+        new Parser<BufferStream>{strategy, prediction, console});
+    parsers.back()->setErrorStream(messages[worker]);
+  }
+
+  OrderedOutput results{filenames.size(), output, errors};
+  runTasks(filenames.size(), workers,
+           [&](size_t const worker, size_t const file) {
+             results.add(file, parseFile(*parsers[worker], messages[worker],
+                                         filenames[file]));
+           });
+  return results.getFailures();
+}
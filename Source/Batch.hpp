@@ -0,0 +1,74 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Parser.hpp"
+
+using std::ostream;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function checks if the given path specifies a directory.
+ *
+ * @param path This parameter stores the path this function checks.
+ *
+ * @retval true If `path` specifies a directory
+ *         false Otherwise
+ */
+bool isDirectory(string const &path);
+
+/**
+ * @brief This function determines the files specified by the given paths.
+ *
+ * For each directory the function adds all files with the extension `.yaml`
+ * or `.yml` inside the directory and its subdirectories, sorted by their
+ * path. The function adds all other paths unchanged.
+ *
+ * @param paths This parameter stores the paths of files and directories.
+ *
+ * @return The names of all files specified by `paths`
+ *
+ * @throws std::system_error If the function is unable to read a directory
+ */
+vector<string> listFiles(vector<string> const &paths);
+
+/**
+ * @brief This function parses multiple files in parallel.
+ *
+ * Each worker thread uses its own parser session. Independent of the order in
+ * which the workers finish their files, the function writes the keys and the
+ * error messages of the files in the order of `filenames`.
+ *
+ * @param filenames This parameter stores the names of the files this function
+ *                  parses.
+ * @param threads This number specifies the number of worker threads. The
+ *                value `0` specifies one worker per hardware thread.
+ * @param strategy This parameter specifies how the parser sessions turn
+ *                 tokens into keys.
+ * @param prediction This parameter specifies the prediction mode of the ANTLR
+ *                   parsers.
+ * @param console This parameter stores the logger that receives the trace
+ *                messages of the lexers, or `nullptr`.
+ * @param output This parameter stores the stream that receives the keys of
+ *               all files.
+ * @param errors This parameter stores the stream that receives the error
+ *               messages of all files.
+ *
+ * @return The number of files this function was unable to read or parse
+ */
+size_t parseFiles(vector<string> const &filenames, size_t const threads,
+                  Strategy const strategy, Prediction const prediction,
+                  shared_ptr<logger> const &console, ostream &output,
+                  ostream &errors);
+
+#endif // BATCH_HPP
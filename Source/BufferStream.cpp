@@ -0,0 +1,90 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "BufferStream.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a stream for the given buffer.
+ *
+ * @param data This pointer stores the start of the buffer.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param sourceName This text specifies the name of the input source.
+ */
+BufferStream::BufferStream(char const *data, size_t const size,
+                           string const &sourceName)
+    : begin{data}, position{data}, end{data + size}, name{sourceName} {}
+
+/**
+ * @brief This method marks the current position of the stream.
+ *
+ * Since the whole input is always available, marks are not necessary.
+ *
+ * @return An arbitrary marker value
+ */
+ssize_t BufferStream::mark() { return -1; }
+
+/**
+ * @brief This method releases a marker returned by `mark`.
+ *
+ * @param marker This parameter specifies the marker this function releases.
+ */
+void BufferStream::release(ssize_t marker __attribute__((unused))) {}
+
+/**
+ * @brief This method changes the current position of the stream.
+ *
+ * @param index This number specifies the new position (byte offset) of the
+ *              stream.
+ */
+void BufferStream::seek(size_t index) {
+  position = begin + std::min(index, size());
+}
+
+/**
+ * @brief This method returns the size of the stream.
+ *
+ * @return The number of bytes in the stream
+ */
+size_t BufferStream::size() { return static_cast<size_t>(end - begin); }
+
+/**
+ * @brief This method returns the name of the input source.
+ *
+ * @return A string containing the name of the input source
+ */
+string BufferStream::getSourceName() const {
+  return name.empty() ? IntStream::UNKNOWN_SOURCE_NAME : name;
+}
+
+/**
+ * @brief This method returns the text in the given range.
+ *
+ * @param interval This parameter specifies the start and stop index of the
+ *                 requested text. If the stop index points into a
+ *                 multi-byte sequence, then the returned text includes the
+ *                 rest of this sequence.
+ *
+ * @return A copy of the text between start and stop index (inclusive)
+ */
+string BufferStream::getText(Interval const &interval) {
+  if (interval.a < 0 || interval.b < interval.a ||
+      static_cast<size_t>(interval.a) >= size()) {
+    return "";
+  }
+
+  size_t start = static_cast<size_t>(interval.a);
+  size_t stop = std::min(static_cast<size_t>(interval.b), size() - 1);
+  while (stop + 1 < size() &&
+         isContinuation(static_cast<unsigned char>(begin[stop + 1]))) {
+    stop++;
+  }
+  return string(begin + start, stop - start + 1);
+}
+
+/**
+ * @brief This method returns the whole content of the stream.
+ *
+ * @return A copy of the buffer
+ */
+string BufferStream::toString() const { return string(begin, end); }
@@ -0,0 +1,225 @@
+#ifndef BUFFER_STREAM_HPP
+#define BUFFER_STREAM_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+
+using std::string;
+
+using antlr4::CharStream;
+using antlr4::IntStream;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides a character stream for a contiguous buffer of
+ *        UTF-8 encoded text stored in memory.
+ *
+ * The stream does not copy or transcode the buffer. The caller has to make
+ * sure that the data stays valid as long as the stream (and all tokens
+ * referring to the stream) exist.
+ *
+ * Unlike `ANTLRInputStream`, which decodes its whole input into UTF-32, this
+ * stream works on UTF-8 code units: `LA` returns single bytes and all
+ * indices (and hence the start and stop indices of tokens) are byte offsets.
+ * Since every byte of a multi-byte UTF-8 sequence is larger than `0x7f`, a
+ * lexer that only looks for ASCII characters does not need to decode code
+ * points at all. Code that needs to know where a character starts can use
+ * `isContinuation`.
+ *
+ * The class is final and defines the methods used for every character
+ * (`LA`, `consume` and `index`) inline. This way code that uses this class
+ * directly (instead of through a `CharStream` pointer) does not need any
+ * virtual function calls to access the input.
+ */
+class BufferStream final : public CharStream {
+  /** This pointer stores the start of the buffer. */
+  char const *begin;
+
+  /** This pointer stores the current position inside the buffer. */
+  char const *position;
+
+  /** This pointer stores the location directly after the buffer. */
+  char const *end;
+
+  /** This variable stores the name of the input source. */
+  string name;
+
+public:
+  /**
+   * @brief This constructor creates a stream for the given buffer.
+   *
+   * @param data This pointer stores the start of the buffer.
+   * @param size This number specifies the number of bytes in `data`.
+   * @param sourceName This text specifies the name of the input source.
+   */
+  BufferStream(char const *data, size_t const size,
+               string const &sourceName = "");
+
+  /**
+   * @brief This function checks if the given code unit continues a multi-byte
+   *        UTF-8 sequence.
+   *
+   * @param character This parameter stores a value returned by `LA`.
+   *
+   * @retval true If `character` is not the first byte of a code point
+   *         false Otherwise
+   */
+  static bool isContinuation(size_t const character);
+
+  /**
+   * @brief This method returns the start of the buffer.
+   *
+   * @return A pointer to the first byte of the stream
+   */
+  char const *data() const;
+
+  /**
+   * @brief This method returns the location of the current byte.
+   *
+   * Together with `remaining` this method allows code to scan the input
+   * directly, without calling `LA` for every byte.
+   *
+   * @return A pointer to the current position inside the buffer
+   */
+  char const *current() const;
+
+  /**
+   * @brief This method returns the number of bytes the stream did not consume
+   *        yet.
+   *
+   * @return The number of bytes between the current position and the end of
+   *         the buffer
+   */
+  size_t remaining() const;
+
+  /**
+   * @brief This method consumes the given number of bytes.
+   *
+   * @param bytes This number specifies the number of bytes this method
+   *              consumes. The value must not be larger than `remaining()`.
+   */
+  void skip(size_t const bytes);
+
+  /**
+   * @brief This method consumes the current byte.
+   */
+  void consume() override;
+
+  /**
+   * @brief This method returns the value of the byte at the given offset.
+   *
+   * @param offset This number specifies the offset of the byte relative to
+   *               the current position. The value `1` specifies the current
+   *               byte, `-1` the previously consumed byte.
+   *
+   * @return The byte at `offset` or `EOF`, if `offset` is outside of the
+   *         buffer
+   */
+  size_t LA(ssize_t offset) override;
+
+  /**
+   * @brief This method marks the current position of the stream.
+   *
+   * Since the whole input is always available, marks are not necessary.
+   *
+   * @return An arbitrary marker value
+   */
+  ssize_t mark() override;
+
+  /**
+   * @brief This method releases a marker returned by `mark`.
+   *
+   * @param marker This parameter specifies the marker this function releases.
+   */
+  void release(ssize_t marker) override;
+
+  /**
+   * @brief This method returns the current position inside the stream.
+   *
+   * @return The byte offset of the current position
+   */
+  size_t index() override;
+
+  /**
+   * @brief This method changes the current position of the stream.
+   *
+   * @param index This number specifies the new position (byte offset) of
+   *              the stream.
+   */
+  void seek(size_t index) override;
+
+  /**
+   * @brief This method returns the size of the stream.
+   *
+   * @return The number of bytes in the stream
+   */
+  size_t size() override;
+
+  /**
+   * @brief This method returns the name of the input source.
+   *
+   * @return A string containing the name of the input source
+   */
+  string getSourceName() const override;
+
+  /**
+   * @brief This method returns the text in the given range.
+   *
+   * @param interval This parameter specifies the start and stop index of the
+   *                 requested text. If the stop index points into a
+   *                 multi-byte sequence, then the returned text includes the
+   *                 rest of this sequence.
+   *
+   * @return A copy of the text between start and stop index (inclusive)
+   */
+  string getText(Interval const &interval) override;
+
+  /**
+   * @brief This method returns the whole content of the stream.
+   *
+   * @return A copy of the buffer
+   */
+  string toString() const override;
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline bool BufferStream::isContinuation(size_t const character) {
+  return (character & 0xc0) == 0x80;
+}
+
+inline char const *BufferStream::data() const { return begin; }
+
+inline char const *BufferStream::current() const { return position; }
+
+inline size_t BufferStream::remaining() const {
+  return static_cast<size_t>(end - position);
+}
+
+inline void BufferStream::skip(size_t const bytes) { position += bytes; }
+
+inline void BufferStream::consume() {
+  if (position >= end) {
+    throw antlr4::IllegalStateException("cannot consume EOF");
+  }
+  position++;
+}
+
+inline size_t BufferStream::LA(ssize_t offset) {
+  if (offset > 0 && offset <= end - position) {
+    return static_cast<unsigned char>(position[offset - 1]);
+  }
+  if (offset < 0 && -offset <= position - begin) {
+    return static_cast<unsigned char>(position[offset]);
+  }
+  return IntStream::EOF;
+}
+
+inline size_t BufferStream::index() {
+  return static_cast<size_t>(position - begin);
+}
+
+#endif // BUFFER_STREAM_HPP
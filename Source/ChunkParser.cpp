@@ -0,0 +1,112 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "ChunkParser.hpp"
+#include "ErrorListener.hpp"
+#include "EventParser.hpp"
+#include "Listener.hpp"
+#include "YAMLLexer.hpp"
+
+using std::endl;
+
+using antlr4::ParseCancellationException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parser.
+ *
+ * @param batch This number specifies the number of keys the parser passes to
+ *              the consumer at once.
+ * @param output This parameter stores the logger that receives the trace
+ *               messages of the lexer. If this parameter is `nullptr`, then
+ *               the lexer does not print any messages.
+ */
+ChunkParser::ChunkParser(size_t const batch, shared_ptr<logger> output)
+    : batchSize{batch}, console{output} {}
+
+/**
+ * @brief This destructor destroys the lexer of the parser.
+ */
+ChunkParser::~ChunkParser() {}
+
+/**
+ * @brief This method converts YAML data to keys.
+ *
+ * @param input This parameter stores the YAML data the method parses.
+ * @param parent This key specifies the parent of all keys in the result. The
+ *               method does not modify this key.
+ * @param consumer This function receives the keys in sorted batches, while
+ *                 the method parses the input. If the lexer is unable to
+ *                 tokenize the input, then the method reports the error and
+ *                 does not pass on the keys of the current batch. The
+ *                 consumer might have received earlier batches already.
+ *
+ * @throws std::runtime_error If the input contains multiple documents, the
+ *                            parser already passed keys of the first
+ *                            document to `consumer` and `setAlwaysNest` was
+ *                            not enabled
+ */
+void ChunkParser::parse(ChunkStream *input, CppKey const &parent,
+                        function<void(CppKeySet &)> const &consumer) {
+  errors = 0;
+  if (!lexer) {
+    lexer.reset(new YAMLLexer<ChunkStream>{input, console});
+    errorListener.reset(
+        new ErrorListener{&lexer->getLineIndex(), *errorStream});
+  } else {
+    lexer->reset(input);
+  }
+
+  // The listener copies the text of each scalar, as soon as it receives the
+  // token. The lexer can therefore release the input of earlier tokens.
+  KeyListener listener{parent.dup()};
+  listener.setConsumer(consumer, batchSize);
+  if (alwaysNest) {
+    listener.nestAllDocuments();
+  }
+  EventParser events{lexer.get()};
+  events.setErrorListener(errorListener.get());
+  try {
+    errors = events.parse(listener);
+  } catch (ParseCancellationException const &error) {
+    // Like the other parsers, we report the position of the lexer, since the
+    // exception does not store the location of the error
+    size_t const index = lexer->getInputStream()->index();
+    LineIndex const &positions = lexer->getLineIndex();
+    *errorStream << positions.line(index) << ":" << positions.column(index)
+                 << " " << error.what() << endl;
+    errors = 1;
+    return;
+  }
+  listener.flush();
+}
+
+/**
+ * @brief This method sets the stream the parser writes error messages to.
+ *
+ * @param stream This parameter stores the stream that receives the error
+ *               messages of all following calls of `parse`.
+ */
+void ChunkParser::setErrorStream(ostream &stream) {
+  errorStream = &stream;
+  if (errorListener) {
+    errorListener->setOutput(stream);
+  }
+}
+
+/**
+ * @brief This method specifies if the parser stores every document below its
+ *        array base name.
+ *
+ * @param always This boolean specifies if the parser stores the keys of the
+ *               first document below `#0`, even if the input contains only a
+ *               single document.
+ */
+void ChunkParser::setAlwaysNest(bool const always) { alwaysNest = always; }
+
+/**
+ * @brief This method returns the number of syntax errors in the last input.
+ *
+ * @return The number of errors the lexer and parser reported
+ */
+size_t ChunkParser::getNumberOfSyntaxErrors() const { return errors; }
@@ -0,0 +1,147 @@
+#ifndef CHUNK_PARSER_HPP
+#define CHUNK_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include <kdb.hpp>
+#include <spdlog/spdlog.h>
+
+#include "ChunkStream.hpp"
+
+using std::function;
+using std::ostream;
+using std::shared_ptr;
+using std::unique_ptr;
+
+using spdlog::logger;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Types --------------------------------------------------------------------
+
+// The headers of the lexer and the error listener do not use an include guard
+template <typename Input> class YAMLLexer;
+class ErrorListener;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts YAML data of arbitrary size to keys, using a
+ *        constant amount of memory.
+ *
+ * The parser reads its input in chunks through a `ChunkStream`. The event
+ * parser reads the tokens of the lexer one by one, without buffering them
+ * (the ANTLR parser keeps the context of every rule it matched). The listener
+ * passes the keys to a consumer in batches (see `KeyListener`). The lexer
+ * releases the input and the tokens in front of the last token, the event
+ * parser only stores the nesting of the current node and the listener only
+ * stores the keys of the current batch. The memory usage of the parser
+ * therefore does not depend on the size of the input, but only on the size
+ * of a chunk, the size of a batch, the length of the longest token and the
+ * nesting depth of the data.
+ *
+ * The keys of each batch are sorted, but the batches are not: A key of a
+ * later batch might be located in front of a key of an earlier batch. Like
+ * the other parsers, the parser nests the keys of a stream with multiple
+ * documents below `#0`, `#1`, and so on. Since the parser only knows that a
+ * stream contains multiple documents, after it reached the second one, it
+ * fails, if it already passed keys of the first document to the consumer.
+ * To parse such streams, call `setAlwaysNest`: The parser then stores every
+ * document below its array base name from the start, even if the stream
+ * contains only a single document.
+ */
+class ChunkParser {
+  /** This number specifies the number of keys in a batch. */
+  size_t batchSize;
+
+  /** This variable stores the logger for the trace messages of the lexer. */
+  shared_ptr<logger> console;
+
+  /** This variable stores the lexer of the parser. */
+  unique_ptr<YAMLLexer<ChunkStream>> lexer;
+
+  /** This variable stores the listener that reports syntax errors. */
+  unique_ptr<ErrorListener> errorListener;
+
+  /** This variable stores the stream the parser writes error messages to. */
+  ostream *errorStream = &std::cerr;
+
+  /** This variable stores the number of syntax errors in the last input. */
+  size_t errors = 0;
+
+  /**
+   * This boolean specifies if the parser stores the keys of a single
+   * document below `#0`.
+   */
+  bool alwaysNest = false;
+
+public:
+  /**
+   * @brief This constructor creates a new parser.
+   *
+   * @param batch This number specifies the number of keys the parser passes
+   *              to the consumer at once.
+   * @param output This parameter stores the logger that receives the trace
+   *               messages of the lexer. If this parameter is `nullptr`, then
+   *               the lexer does not print any messages.
+   */
+  ChunkParser(size_t const batch = 10000,
+              shared_ptr<logger> output = nullptr);
+
+  /**
+   * @brief This destructor destroys the lexer of the parser.
+   */
+  ~ChunkParser();
+
+  /**
+   * @brief This method converts YAML data to keys.
+   *
+   * @param input This parameter stores the YAML data the method parses.
+   * @param parent This key specifies the parent of all keys in the result.
+   *               The method does not modify this key.
+   * @param consumer This function receives the keys in sorted batches, while
+   *                 the method parses the input. If the lexer is unable to
+   *                 tokenize the input, then the method reports the error and
+   *                 does not pass on the keys of the current batch. The
+   *                 consumer might have received earlier batches already.
+   *
+   * @throws std::runtime_error If the input contains multiple documents,
+   *                            the parser already passed keys of the first
+   *                            document to `consumer` and `setAlwaysNest` was
+   *                            not enabled
+   */
+  void parse(ChunkStream *input, CppKey const &parent,
+             function<void(CppKeySet &)> const &consumer);
+
+  /**
+   * @brief This method sets the stream the parser writes error messages to.
+   *
+   * @param stream This parameter stores the stream that receives the error
+   *               messages of all following calls of `parse`.
+   */
+  void setErrorStream(ostream &stream);
+
+  /**
+   * @brief This method specifies if the parser stores every document below
+   *        its array base name.
+   *
+   * @param always This boolean specifies if the parser stores the keys of the
+   *               first document below `#0`, even if the input contains only
+   *               a single document.
+   */
+  void setAlwaysNest(bool const always);
+
+  /**
+   * @brief This method returns the number of syntax errors in the last input.
+   *
+   * @return The number of errors the lexer and parser reported
+   */
+  size_t getNumberOfSyntaxErrors() const;
+};
+
+#endif // CHUNK_PARSER_HPP
@@ -0,0 +1,237 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "ChunkStream.hpp"
+
+using std::min;
+
+using antlr4::UnsupportedOperationException;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/** This code point replaces invalid UTF-8 sequences. */
+char32_t const REPLACEMENT_CHARACTER = 0xfffd;
+
+/**
+ * @brief This function checks if the given byte continues a multi-byte UTF-8
+ *        sequence.
+ *
+ * @param byte This parameter stores the byte this function checks.
+ *
+ * @retval true If `byte` is not the first byte of a code point
+ *         false Otherwise
+ */
+bool isContinuation(char const byte) {
+  return (static_cast<unsigned char>(byte) & 0xc0) == 0x80;
+}
+
+/**
+ * @brief This function decodes UTF-8 encoded text into code points.
+ *
+ * The function replaces each invalid sequence with `U+FFFD`.
+ *
+ * @param text This pointer stores the start of the UTF-8 encoded text.
+ * @param size This number specifies the number of bytes in `text`.
+ * @param last This boolean specifies if `text` contains the end of the
+ *             input. Otherwise the function does not decode a code point at
+ *             the end of `text`, whose sequence continues behind `text`.
+ * @param characters This string stores the decoded code points.
+ *
+ * @return The number of bytes the function decoded
+ */
+size_t decode(char const *text, size_t const size, bool const last,
+              u32string &characters) {
+  size_t position = 0;
+  while (position < size) {
+    unsigned char const lead = static_cast<unsigned char>(text[position]);
+    size_t const length =
+        lead < 0xc0 ? 1 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+    if (position + length > size && !last) {
+      break;
+    }
+
+    char32_t character = length == 1 ? lead : lead & (0x7f >> length);
+    size_t bytes = 1;
+    while (bytes < length && position + bytes < size &&
+           isContinuation(text[position + bytes])) {
+      character = (character << 6) | (text[position + bytes] & 0x3f);
+      bytes++;
+    }
+    bool const valid = bytes == length && (lead < 0x80 || lead >= 0xc0) &&
+                       lead < 0xf8;
+    characters.push_back(valid ? character : REPLACEMENT_CHARACTER);
+    position += bytes;
+  }
+  return position;
+}
+
+/**
+ * @brief This function encodes code points as UTF-8.
+ *
+ * @param characters This pointer stores the first code point.
+ * @param size This number specifies the number of code points.
+ *
+ * @return The UTF-8 encoded text of the code points
+ */
+string encode(char32_t const *characters, size_t const size) {
+  string text;
+  text.reserve(size);
+  for (char32_t const *character = characters; character < characters + size;
+       character++) {
+    char32_t const value = *character;
+    if (value < 0x80) {
+      text += static_cast<char>(value);
+    } else if (value < 0x800) {
+      text += static_cast<char>(0xc0 | (value >> 6));
+      text += static_cast<char>(0x80 | (value & 0x3f));
+    } else if (value < 0x10000) {
+      text += static_cast<char>(0xe0 | (value >> 12));
+      text += static_cast<char>(0x80 | ((value >> 6) & 0x3f));
+      text += static_cast<char>(0x80 | (value & 0x3f));
+    } else {
+      text += static_cast<char>(0xf0 | (value >> 18));
+      text += static_cast<char>(0x80 | ((value >> 12) & 0x3f));
+      text += static_cast<char>(0x80 | ((value >> 6) & 0x3f));
+      text += static_cast<char>(0x80 | (value & 0x3f));
+    }
+  }
+  return text;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a character stream that reads its data from
+ *        the given input stream.
+ *
+ * @param stream This parameter stores the stream that provides the UTF-8
+ *               encoded text.
+ * @param chunkSize This number specifies the number of bytes the stream reads
+ *                  at once.
+ * @param sourceName This text specifies the name of the input source.
+ */
+ChunkStream::ChunkStream(istream &stream, size_t const chunkSize,
+                         string const &sourceName)
+    : source{&stream}, chunk{chunkSize > 0 ? chunkSize : 1},
+      name{sourceName} {}
+
+/**
+ * @brief This method marks the current position of the stream.
+ *
+ * The stream keeps all characters, until its user calls `discard`. It
+ * therefore does not need marks.
+ *
+ * @return An arbitrary marker value
+ */
+ssize_t ChunkStream::mark() { return -1; }
+
+/**
+ * @brief This method releases a marker returned by `mark`.
+ *
+ * @param marker This parameter specifies the marker this function releases.
+ */
+void ChunkStream::release(ssize_t marker __attribute__((unused))) {}
+
+/**
+ * @brief This method changes the current position of the stream.
+ *
+ * @param index This number specifies the new position of the stream.
+ *
+ * @throws UnsupportedOperationException If the stream already discarded the
+ *                                       character at `index`
+ */
+void ChunkStream::seek(size_t index) {
+  if (index < released) {
+    throw UnsupportedOperationException(
+        "Unable to seek to a discarded character");
+  }
+  while (index > size() && load()) {
+  }
+  position = min(index, size());
+}
+
+/**
+ * @brief This method returns the number of characters the stream read so far.
+ *
+ * @return The index behind the last character of the window
+ */
+size_t ChunkStream::size() { return first + window.size(); }
+
+/**
+ * @brief This method returns the name of the input source.
+ *
+ * @return A string containing the name of the input source
+ */
+string ChunkStream::getSourceName() const {
+  return name.empty() ? IntStream::UNKNOWN_SOURCE_NAME : name;
+}
+
+/**
+ * @brief This method returns the text in the given range.
+ *
+ * @param interval This parameter specifies the start and stop index of the
+ *                 requested text.
+ *
+ * @return The UTF-8 encoded text between the start and stop index
+ *
+ * @throws UnsupportedOperationException If the stream already discarded the
+ *                                       start of the text
+ */
+string ChunkStream::getText(Interval const &interval) {
+  if (interval.a < 0 || interval.b < interval.a ||
+      static_cast<size_t>(interval.a) >= size()) {
+    return "";
+  }
+
+  size_t const start = static_cast<size_t>(interval.a);
+  if (start < released) {
+    throw UnsupportedOperationException(
+        "Unable to retrieve the text of discarded characters");
+  }
+  size_t const stop = min(static_cast<size_t>(interval.b), size() - 1);
+  return encode(window.data() + (start - first), stop - start + 1);
+}
+
+/**
+ * @brief This method returns the characters the stream did not discard yet.
+ *
+ * @return The UTF-8 encoded text of the window
+ */
+string ChunkStream::toString() const {
+  return encode(window.data() + (released - first),
+                window.size() - (released - first));
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method adds the characters of the next chunk to the window.
+ *
+ * @retval true If the method added at least one character
+ *         false If the stream already read all of its input
+ */
+bool ChunkStream::load() {
+  size_t const unused = released - first;
+  if (unused > 0 && unused >= window.size() / 2) {
+    window.erase(0, unused);
+    first = released;
+  }
+
+  size_t const characters = window.size();
+  // A very small chunk might not contain a whole code point
+  while (window.size() == characters && !exhausted) {
+    size_t const kept = bytes.size();
+    bytes.resize(kept + chunk);
+    source->read(&bytes[kept], static_cast<std::streamsize>(chunk));
+    size_t const count = static_cast<size_t>(source->gcount());
+    bytes.resize(kept + count);
+    exhausted = count == 0;
+    bytes.erase(0, decode(bytes.data(), bytes.size(), exhausted, window));
+  }
+  return window.size() > characters;
+}
@@ -0,0 +1,233 @@
+#ifndef CHUNK_STREAM_HPP
+#define CHUNK_STREAM_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <istream>
+#include <string>
+
+#include <antlr4-runtime.h>
+
+using std::istream;
+using std::string;
+using std::u32string;
+
+using antlr4::CharStream;
+using antlr4::IntStream;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides a character stream for UTF-8 encoded text, which
+ *        it reads from a standard input stream in chunks of fixed size.
+ *
+ * Like `ANTLRInputStream`, the stream decodes its input into code points:
+ * `LA` returns code points and all indices count code points. Unlike
+ * `ANTLRInputStream`, the stream only keeps a window of its input in memory.
+ * The stream reads the next chunk, when someone accesses a character behind
+ * the window. The user of the stream calls `discard`, if it does not need the
+ * characters in front of a position any more. The stream then removes these
+ * characters from the window, before it reads further chunks. This way the
+ * memory usage of the stream only depends on the size of a chunk and the
+ * distance between the current position and the oldest position the user
+ * still needs, not on the size of the input.
+ *
+ * The stream does not know the size of its input in advance. It therefore
+ * reports the number of characters it read so far as its size.
+ *
+ * The class is final and defines the methods used for every character
+ * (`LA`, `consume` and `index`) inline, like `BufferStream`.
+ */
+class ChunkStream final : public CharStream {
+  /** This variable stores the stream the class reads the chunks from. */
+  istream *source;
+
+  /** This number specifies the number of bytes the stream reads at once. */
+  size_t chunk;
+
+  /**
+   * This string stores the bytes of a code point that started at the end of
+   * the last chunk, but continues in the next one.
+   */
+  string bytes;
+
+  /** This string stores the window of decoded characters. */
+  u32string window;
+
+  /** This number stores the index of the first character in `window`. */
+  size_t first = 0;
+
+  /** This number stores the index of the current character. */
+  size_t position = 0;
+
+  /**
+   * This number stores the index in front of which the user does not need
+   * any characters.
+   */
+  size_t released = 0;
+
+  /** This boolean specifies if the stream read all of its input. */
+  bool exhausted = false;
+
+  /** This variable stores the name of the input source. */
+  string name;
+
+  /**
+   * @brief This method adds the characters of the next chunk to the window.
+   *
+   * Before the method extends the window, it removes the released characters
+   * from the window, if they make up at least half of it.
+   *
+   * @retval true If the method added at least one character
+   *         false If the stream already read all of its input
+   */
+  bool load();
+
+public:
+  /**
+   * @brief This constructor creates a character stream that reads its data
+   *        from the given input stream.
+   *
+   * @param stream This parameter stores the stream that provides the UTF-8
+   *               encoded text. It has to exist as long as this object.
+   * @param chunkSize This number specifies the number of bytes the stream
+   *                  reads at once.
+   * @param sourceName This text specifies the name of the input source.
+   */
+  ChunkStream(istream &stream, size_t const chunkSize = 64 * 1024,
+              string const &sourceName = "");
+
+  /**
+   * @brief This method tells the stream that its user does not need the
+   *        characters in front of the given position any more.
+   *
+   * @param index This number specifies the index of the first character the
+   *              user might still access. The method ignores positions behind
+   *              the current position.
+   */
+  void discard(size_t const index);
+
+  /**
+   * @brief This method consumes the current character.
+   */
+  void consume() override;
+
+  /**
+   * @brief This method returns the value of the character at the given
+   *        offset.
+   *
+   * @param offset This number specifies the offset of the character relative
+   *               to the current position. The value `1` specifies the
+   *               current character, `-1` the previously consumed character.
+   *
+   * @return The code point at `offset` or `EOF`, if `offset` is outside of
+   *         the input or in front of the window
+   */
+  size_t LA(ssize_t offset) override;
+
+  /**
+   * @brief This method marks the current position of the stream.
+   *
+   * The stream keeps all characters, until its user calls `discard`. It
+   * therefore does not need marks.
+   *
+   * @return An arbitrary marker value
+   */
+  ssize_t mark() override;
+
+  /**
+   * @brief This method releases a marker returned by `mark`.
+   *
+   * @param marker This parameter specifies the marker this function releases.
+   */
+  void release(ssize_t marker) override;
+
+  /**
+   * @brief This method returns the current position inside the stream.
+   *
+   * @return The index of the current character
+   */
+  size_t index() override;
+
+  /**
+   * @brief This method changes the current position of the stream.
+   *
+   * @param index This number specifies the new position of the stream. The
+   *              position must not be located in front of the characters
+   *              released by `discard`.
+   *
+   * @throws UnsupportedOperationException If the stream already discarded
+   *                                       the character at `index`
+   */
+  void seek(size_t index) override;
+
+  /**
+   * @brief This method returns the number of characters the stream read so
+   *        far.
+   *
+   * @return The index behind the last character of the window
+   */
+  size_t size() override;
+
+  /**
+   * @brief This method returns the name of the input source.
+   *
+   * @return A string containing the name of the input source
+   */
+  string getSourceName() const override;
+
+  /**
+   * @brief This method returns the text in the given range.
+   *
+   * @param interval This parameter specifies the start and stop index of the
+   *                 requested text.
+   *
+   * @return The UTF-8 encoded text between the start and stop index
+   *
+   * @throws UnsupportedOperationException If the stream already discarded
+   *                                       the start of the text
+   */
+  string getText(Interval const &interval) override;
+
+  /**
+   * @brief This method returns the characters the stream did not discard yet.
+   *
+   * @return The UTF-8 encoded text of the window
+   */
+  string toString() const override;
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline void ChunkStream::discard(size_t const index) {
+  released = std::max(released, std::min(index, position));
+}
+
+inline void ChunkStream::consume() {
+  if (position - first >= window.size() && !load()) {
+    throw antlr4::IllegalStateException("cannot consume EOF");
+  }
+  position++;
+}
+
+inline size_t ChunkStream::LA(ssize_t offset) {
+  if (offset > 0) {
+    size_t const index = position + static_cast<size_t>(offset) - 1;
+    while (index - first >= window.size()) {
+      if (!load()) {
+        return IntStream::EOF;
+      }
+    }
+    return window[index - first];
+  }
+  if (offset < 0 && static_cast<size_t>(-offset) <= position - first) {
+    return window[position - first - static_cast<size_t>(-offset)];
+  }
+  return IntStream::EOF;
+}
+
+inline size_t ChunkStream::index() { return position; }
+
+#endif // CHUNK_STREAM_HPP
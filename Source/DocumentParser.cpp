@@ -0,0 +1,422 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "DocumentParser.hpp"
+#include "Listener.hpp"
+#include "ThreadPool.hpp"
+
+using std::atomic;
+using std::max;
+using std::memchr;
+using std::min;
+using std::string;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function checks if a line starts with a document marker.
+ *
+ * Like the lexer, the function only accepts a marker followed by a space or
+ * the end of the line.
+ *
+ * @param line This pointer stores the start of the line.
+ * @param size This number specifies the size of the line (excluding the
+ *             newline character).
+ * @param marker This character specifies the character of the marker (`-` for
+ *               a document start marker, `.` for a document end marker).
+ *
+ * @retval true If the line starts with the specified marker
+ *         false Otherwise
+ */
+bool isMarker(char const *line, size_t const size, char const marker) {
+  return size >= 3 && line[0] == marker && line[1] == marker &&
+         line[2] == marker && (size == 3 || line[3] == ' ');
+}
+
+/**
+ * @brief This function checks if a part of a line contains any content apart
+ *        from spaces and a comment.
+ *
+ * @param text This pointer stores the start of the text.
+ * @param size This number specifies the size of the text (excluding the
+ *             newline character).
+ *
+ * @retval true If the text contains content
+ *         false If the text is empty, or contains only spaces and a comment
+ */
+bool hasContent(char const *text, size_t const size) {
+  size_t position = 0;
+  while (position < size && text[position] == ' ') {
+    position++;
+  }
+  return position < size && text[position] != '#';
+}
+
+/**
+ * This number specifies how many parts of a block mapping each worker parses
+ * on average. Smaller parts balance the work of the workers better, if some
+ * parts contain more complex data than others.
+ */
+size_t const PARTS_PER_WORKER = 4;
+
+/**
+ * @brief This function returns the size of a line.
+ *
+ * @param text This pointer stores the start of the text.
+ * @param size This number specifies the size of `text`.
+ * @param start This number specifies the offset of the first byte of the
+ *              line.
+ *
+ * @return The number of bytes in the line (excluding the newline character)
+ */
+size_t lineLength(char const *text, size_t const size, size_t const start) {
+  auto const newline =
+      static_cast<char const *>(memchr(text + start, '\n', size - start));
+  return (newline == nullptr ? text + size : newline) - (text + start);
+}
+
+/**
+ * @brief This function checks if a line might start a top level key of a
+ *        block mapping.
+ *
+ * @param line This pointer stores the start of the line.
+ * @param size This number specifies the size of the line (excluding the
+ *             newline character).
+ *
+ * @retval true If the line starts with content in the first column, which is
+ *              neither a comment, a sequence element, nor a document marker
+ *         false Otherwise
+ */
+bool isKeyLine(char const *line, size_t const size) {
+  if (size == 0 || line[0] == ' ' || line[0] == '\t' || line[0] == '\r' ||
+      line[0] == '#') {
+    return false;
+  }
+  bool const element = line[0] == '-' && (size == 1 || line[1] == ' ');
+  return !element && !isMarker(line, size, '-') && !isMarker(line, size, '.');
+}
+
+/**
+ * @brief This function checks if the document of a stream starts with a top
+ *        level key of a block mapping.
+ *
+ * @param text This pointer stores the start of the UTF-8 encoded stream.
+ * @param size This number specifies the size of `text` in bytes.
+ *
+ * @retval true If the first content of the stream (apart from comments and
+ *              document markers) is a line that starts with a top level key
+ *         false Otherwise
+ */
+bool startsWithMapping(char const *text, size_t const size) {
+  for (size_t start = 0; start < size;) {
+    char const *line = text + start;
+    size_t const length = lineLength(text, size, start);
+    bool const marker =
+        isMarker(line, length, '-') || isMarker(line, length, '.');
+    if (marker ? hasContent(line + 3, length - 3)
+               : hasContent(line, length)) {
+      return !marker && isKeyLine(line, length);
+    }
+    start += length + 1;
+  }
+  return false;
+}
+
+/**
+ * @brief This function splits a document that contains a block mapping in
+ *        front of top level keys.
+ *
+ * The function searches for the first line that starts with a key after
+ * each multiple of the part size. This way it only looks at a few lines for
+ * each part, instead of the whole text.
+ *
+ * @param text This pointer stores the start of the UTF-8 encoded stream.
+ * @param size This number specifies the size of `text` in bytes.
+ * @param parts This number specifies the maximum number of parts.
+ *
+ * @return The offset of the first byte of each part, or an empty vector if
+ *         the document does not start with a block mapping
+ */
+vector<size_t> splitMapping(char const *text, size_t const size,
+                            size_t const parts) {
+  vector<size_t> starts;
+  if (!startsWithMapping(text, size)) {
+    return starts;
+  }
+
+  starts.push_back(0);
+  size_t const partSize = max(size / parts, size_t{1});
+  for (size_t part = 1; part < parts; part++) {
+    // We start to search at the line behind the current position
+    size_t start = max(part * partSize, starts.back() + 1);
+    start += lineLength(text, size, start - 1);
+    while (start < size && !isKeyLine(text + start,
+                                      lineLength(text, size, start))) {
+      start += lineLength(text, size, start) + 1;
+    }
+    if (start >= size) {
+      break;
+    }
+    starts.push_back(start);
+  }
+  return starts;
+}
+
+} // namespace
+
+/**
+ * @brief This function splits a YAML stream into its documents.
+ *
+ * The splitter does not know about multi-line scalars. It therefore also
+ * splits a (invalid) quoted scalar that contains a line starting with a
+ * document marker.
+ *
+ * @param text This pointer stores the start of the UTF-8 encoded stream.
+ * @param size This number specifies the size of `text` in bytes.
+ *
+ * @return The parts of `text` that contain the documents of the stream, in the
+ *         order of the documents
+ */
+vector<DocumentSpan> splitDocuments(char const *text, size_t const size) {
+  vector<DocumentSpan> documents;
+  // A document without start marker is only possible at the start of the
+  // stream and after a document end marker
+  DocumentSpan bare{0, 0, 1};
+  bool bareAllowed = true;
+
+  size_t line = 1;
+  for (size_t start = 0; start < size; line++) {
+    auto const newline =
+        static_cast<char const *>(memchr(text + start, '\n', size - start));
+    size_t const end = newline == nullptr ? size : newline - text;
+    char const *current = text + start;
+    size_t const length = end - start;
+
+    if (isMarker(current, length, '-')) {
+      documents.push_back(DocumentSpan{start, 0, line});
+      bareAllowed = false;
+    } else if (isMarker(current, length, '.')) {
+      // The part of the next document starts with the end marker. This way
+      // content behind the marker belongs to the next document.
+      bare = DocumentSpan{start, 0, line};
+      bareAllowed = !hasContent(current + 3, length - 3);
+      if (!bareAllowed) {
+        documents.push_back(bare);
+      }
+    } else if (bareAllowed && hasContent(current, length)) {
+      documents.push_back(bare);
+      bareAllowed = false;
+    }
+    start = end + 1;
+  }
+
+  // Each part ends at the start of the next document
+  for (size_t index = 0; index + 1 < documents.size(); index++) {
+    documents[index].end = documents[index + 1].start;
+  }
+  if (!documents.empty()) {
+    documents.back().end = size;
+    documents.front().start = 0;
+    documents.front().line = 1;
+  }
+  return documents;
+}
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parser.
+ *
+ * @param threads This number specifies the number of worker threads. The
+ *                value `0` specifies one worker per hardware thread.
+ * @param how This parameter specifies how the parser sessions turn tokens into
+ *            keys.
+ * @param mode This parameter specifies the prediction mode of the ANTLR
+ *             parsers.
+ * @param split This parameter specifies if the parser splits a single
+ *              document.
+ * @param output This parameter stores the logger that receives the trace
+ *               messages of the lexers, or `nullptr`.
+ */
+DocumentParser::DocumentParser(size_t const threads, Strategy const how,
+                               Prediction const mode, Speculation const split,
+                               shared_ptr<logger> output)
+    : messages(threads == 0 ? hardwareThreads() : threads),
+      speculation{split} {
+  // The sessions only create their lexer and parser for the first input
+  for (auto &stream : messages) {
+    sessions.emplace_back(new Parser<BufferStream>{how, mode, output});
+    sessions.back()->setErrorStream(stream);
+  }
+}
+
+/**
+ * @brief This method converts a stream of YAML documents to a key set.
+ *
+ * @param input This parameter stores the YAML data the method parses.
+ * @param parent This key specifies the parent of all keys in the result. The
+ *               method does not modify this key.
+ *
+ * @return A key set representing the data in `input`
+ */
+CppKeySet DocumentParser::parse(BufferStream *input, CppKey const &parent) {
+  vector<DocumentSpan> const documents =
+      splitDocuments(input->data(), input->size());
+  if (documents.size() > 1) {
+    return parseDocuments(input, documents, parent);
+  }
+
+  if (speculation == Speculation::KEYS && sessions.size() > 1) {
+    vector<size_t> const starts = splitMapping(
+        input->data(), input->size(), PARTS_PER_WORKER * sessions.size());
+    CppKeySet keys;
+    if (starts.size() > 1 && parseMappingParts(input, starts, parent, keys)) {
+      return keys;
+    }
+  }
+
+  // A single document does not use an array base name
+  messages.front().str("");
+  CppKeySet keys = sessions.front()->parse(input, parent);
+  errors = sessions.front()->getNumberOfSyntaxErrors();
+  *errorStream << messages.front().str();
+  return keys;
+}
+
+/**
+ * @brief This method sets the stream the parser writes error messages to.
+ *
+ * @param stream This parameter stores the stream that receives the error
+ *               messages of all following calls of `parse`.
+ */
+void DocumentParser::setErrorStream(ostream &stream) { errorStream = &stream; }
+
+/**
+ * @brief This method returns the number of syntax errors in the last input.
+ *
+ * @return The number of errors the lexers and parsers reported
+ */
+size_t DocumentParser::getNumberOfSyntaxErrors() const { return errors; }
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method parses the given documents in parallel.
+ *
+ * @param input This parameter stores the stream that contains the documents.
+ * @param documents This parameter stores the location of each document inside
+ *                  `input`.
+ * @param parent This key specifies the parent of all keys in the result.
+ *
+ * @return A key set representing the documents
+ */
+CppKeySet DocumentParser::parseDocuments(BufferStream *input,
+                                         vector<DocumentSpan> const &documents,
+                                         CppKey const &parent) {
+  vector<CppKeySet> results(documents.size());
+  vector<string> reports(documents.size());
+  vector<size_t> failures(documents.size(), 0);
+  string const prefix = parent.getName() + "/";
+
+  runTasks(documents.size(), min(sessions.size(), documents.size()),
+           [&](size_t const worker, size_t const index) {
+             DocumentSpan const &document = documents[index];
+             BufferStream part{input->data() + document.start,
+                               document.end - document.start,
+                               input->getSourceName()};
+             CppKey child{(prefix + arrayBaseName(index)).c_str(), KEY_END};
+
+             messages[worker].str("");
+             Parser<BufferStream> &session = *sessions[worker];
+             results[index] = session.parse(&part, child, document.line);
+             failures[index] = session.getNumberOfSyntaxErrors();
+             reports[index] = messages[worker].str();
+           });
+
+  // Like for a sequence, the parent stores the base name of the last document
+  CppKey root = parent.dup();
+  root.setMeta("array", arrayBaseName(documents.size() - 1));
+
+  size_t size = 1;
+  for (auto const &keys : results) {
+    size += keys.size();
+  }
+  CppKeySet keys{size, KS_END};
+  keys.append(root);
+  errors = 0;
+  for (size_t index = 0; index < documents.size(); index++) {
+    if (results[index].size() == 0 && failures[index] == 0) {
+      // Like the listener, we add a key without value for an empty document,
+      // so the array does not contain a hole
+      keys.append(
+          CppKey{(prefix + arrayBaseName(index)).c_str(), KEY_END});
+    }
+    keys.append(results[index]);
+    errors += failures[index];
+    *errorStream << reports[index];
+  }
+  return keys;
+}
+
+/**
+ * @brief This method parses the parts of a block mapping in parallel.
+ *
+ * @param input This parameter stores the stream that contains the mapping.
+ * @param starts This parameter stores the offset of the first byte of each
+ *               part inside `input`.
+ * @param parent This key specifies the parent of all keys in the result.
+ * @param keys This variable stores the key set representing the mapping, if
+ *             the method succeeds.
+ *
+ * @retval true If the method parsed all parts without errors
+ *         false Otherwise
+ */
+bool DocumentParser::parseMappingParts(BufferStream *input,
+                                       vector<size_t> const &starts,
+                                       CppKey const &parent, CppKeySet &keys) {
+  vector<CppKeySet> results(starts.size());
+  // After the first error the workers skip all remaining parts
+  atomic<bool> failed{false};
+
+  runTasks(starts.size(), min(sessions.size(), starts.size()),
+           [&](size_t const worker, size_t const index) {
+             if (failed) {
+               return;
+             }
+             size_t const end =
+                 index + 1 < starts.size() ? starts[index + 1] : input->size();
+             BufferStream part{input->data() + starts[index],
+                               end - starts[index], input->getSourceName()};
+
+             // The serial parser reports the errors, if the guess was wrong
+             messages[worker].str("");
+             results[index] = sessions[worker]->parse(&part, parent);
+             // Only a part that does not start with a key (but with a value
+             // or a sequence) stores data in the parent key
+             if (sessions[worker]->getNumberOfSyntaxErrors() > 0 ||
+                 results[index].lookup(parent.getName())) {
+               failed = true;
+             }
+           });
+  if (failed) {
+    return false;
+  }
+
+  size_t size = 0;
+  for (auto const &result : results) {
+    size += result.size();
+  }
+  keys = CppKeySet{size, KS_END};
+  for (auto const &result : results) {
+    keys.append(result);
+  }
+  errors = 0;
+  return true;
+}
@@ -0,0 +1,200 @@
+#ifndef DOCUMENT_PARSER_HPP
+#define DOCUMENT_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "Parser.hpp"
+
+using std::ostream;
+using std::ostringstream;
+using std::shared_ptr;
+using std::size_t;
+using std::unique_ptr;
+using std::vector;
+
+// -- Types --------------------------------------------------------------------
+
+/** This structure stores the location of a document inside a YAML stream. */
+struct DocumentSpan {
+  /** This variable stores the offset of the first byte of the document. */
+  size_t start;
+
+  /** This variable stores the offset behind the last byte of the document. */
+  size_t end;
+
+  /** This variable stores the line number of the first line of the document. */
+  size_t line;
+};
+
+/** This enumeration lists the ways a `DocumentParser` splits a document. */
+enum class Speculation {
+  /** The parser parses each document on a single thread. */
+  NONE,
+  /**
+   * The parser splits a document with a block mapping at the top level in
+   * front of top level keys, and parses the parts on multiple threads. If the
+   * parts do not match the document, the parser parses the document again on
+   * a single thread.
+   */
+  KEYS
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function splits a YAML stream into its documents.
+ *
+ * The function only looks at the start of each line: A document starts at a
+ * document start marker (`---`) in the first column. After a document end
+ * marker (`...`) a document without start marker starts, if the following
+ * lines contain any content apart from comments.
+ *
+ * Each part starts with the marker (or the content) of its document and
+ * stores the comments behind the document. The parts cover the whole stream:
+ * The first part also contains the comments in front of the first document.
+ * This way each part is a valid YAML stream on its own, which contains exactly
+ * one document of the original stream.
+ *
+ * @param text This pointer stores the start of the UTF-8 encoded stream.
+ * @param size This number specifies the size of `text` in bytes.
+ *
+ * @return The parts of `text` that contain the documents of the stream, in the
+ *         order of the documents
+ */
+vector<DocumentSpan> splitDocuments(char const *text, size_t const size);
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts a stream of YAML documents to a key set, parsing
+ *        multiple documents in parallel.
+ *
+ * The parser first splits the input into its documents (see
+ * `splitDocuments`). Then a pool of workers parses the documents, where each
+ * worker uses its own parser session. The keys of each document are located
+ * below the array base name of the document (`parent/#0`, `parent/#1`, …).
+ * Like for a sequence, the metadata `array` of the parent stores the base
+ * name of the last document. The result is therefore the same as the result
+ * of a single parser session for the whole input.
+ *
+ * If the input contains at most one document, then the first session parses
+ * the input directly. The parser can also speculate that a single document
+ * contains a block mapping, and split the document in front of lines that
+ * start with a top level key (see `Speculation`). Each part then contains a
+ * mapping with some of the top level pairs, which a worker parses on its
+ * own. The result is the union of the key sets of the parts.
+ *
+ * The guess is wrong, if a line that looks like a top level key belongs to a
+ * multi-line quoted scalar, or stores the value of the last key. In the first
+ * case the part in front of the line ends inside the scalar, and the lexer
+ * reports an error. In the second case the part behind the line does not
+ * contain a mapping, so the listener adds the parent key. The lexer does not
+ * support flow collections, so they can not cross the start of a part. After
+ * any error in a part, the parser discards the results of all parts and
+ * parses the document on a single thread. This way the result and the error
+ * messages are always the same as the ones of a single parser session.
+ *
+ * The parser writes the error messages of all documents in the order of the
+ * documents. Each message refers to the line numbers of the whole input.
+ */
+class DocumentParser {
+  /** This vector stores the parser session of each worker. */
+  vector<unique_ptr<Parser<BufferStream>>> sessions;
+
+  /** This vector stores the error messages of each worker. */
+  vector<ostringstream> messages;
+
+  /** This variable stores the stream the parser writes error messages to. */
+  ostream *errorStream = &std::cerr;
+
+  /** This variable specifies if the parser splits a single document. */
+  Speculation speculation;
+
+  /** This variable stores the number of syntax errors in the last input. */
+  size_t errors = 0;
+
+  /**
+   * @brief This method parses the given documents in parallel.
+   *
+   * @param input This parameter stores the stream that contains the
+   *              documents.
+   * @param documents This parameter stores the location of each document
+   *                  inside `input`.
+   * @param parent This key specifies the parent of all keys in the result.
+   *
+   * @return A key set representing the documents
+   */
+  CppKeySet parseDocuments(BufferStream *input,
+                           vector<DocumentSpan> const &documents,
+                           CppKey const &parent);
+
+  /**
+   * @brief This method parses the parts of a block mapping in parallel.
+   *
+   * @param input This parameter stores the stream that contains the mapping.
+   * @param starts This parameter stores the offset of the first byte of each
+   *               part inside `input`.
+   * @param parent This key specifies the parent of all keys in the result.
+   * @param keys This variable stores the key set representing the mapping, if
+   *             the method succeeds.
+   *
+   * @retval true If the method parsed all parts without errors
+   *         false Otherwise
+   */
+  bool parseMappingParts(BufferStream *input, vector<size_t> const &starts,
+                         CppKey const &parent, CppKeySet &keys);
+
+public:
+  /**
+   * @brief This constructor creates a new parser.
+   *
+   * @param threads This number specifies the number of worker threads. The
+   *                value `0` specifies one worker per hardware thread.
+   * @param how This parameter specifies how the parser sessions turn tokens
+   *            into keys.
+   * @param mode This parameter specifies the prediction mode of the ANTLR
+   *             parsers.
+   * @param split This parameter specifies if the parser splits a single
+   *              document.
+   * @param output This parameter stores the logger that receives the trace
+   *               messages of the lexers, or `nullptr`.
+   */
+  DocumentParser(size_t const threads = 0,
+                 Strategy const how = Strategy::TREE,
+                 Prediction const mode = Prediction::TWO_STAGE,
+                 Speculation const split = Speculation::NONE,
+                 shared_ptr<logger> output = nullptr);
+
+  /**
+   * @brief This method converts a stream of YAML documents to a key set.
+   *
+   * @param input This parameter stores the YAML data the method parses.
+   * @param parent This key specifies the parent of all keys in the result.
+   *               The method does not modify this key.
+   *
+   * @return A key set representing the data in `input`
+   */
+  CppKeySet parse(BufferStream *input, CppKey const &parent);
+
+  /**
+   * @brief This method sets the stream the parser writes error messages to.
+   *
+   * @param stream This parameter stores the stream that receives the error
+   *               messages of all following calls of `parse`.
+   */
+  void setErrorStream(ostream &stream);
+
+  /**
+   * @brief This method returns the number of syntax errors in the last input.
+   *
+   * @return The number of errors the lexers and parsers reported
+   */
+  size_t getNumberOfSyntaxErrors() const;
+};
+
+#endif // DOCUMENT_PARSER_HPP
@@ -4,11 +4,49 @@
 
 #include "ErrorListener.hpp"
 
-using std::cerr;
 using std::endl;
 
 // -- Class --------------------------------------------------------------------
 
+/**
+ * @brief This constructor creates a new error listener.
+ *
+ * @param lineIndex This parameter stores the line index the listener uses to
+ *                  determine the position of an offending token.
+ * @param stream This parameter stores the stream the listener writes error
+ *               messages to.
+ */
+ErrorListener::ErrorListener(LineIndex const *lineIndex, ostream &stream)
+    : positions{lineIndex}, output{&stream} {}
+
+/**
+ * @brief This method sets the stream the listener writes error messages to.
+ *
+ * @param stream This parameter stores the new output stream of the listener.
+ */
+void ErrorListener::setOutput(ostream &stream) { output = &stream; }
+
+/**
+ * @brief This method sets the line index the listener uses to determine the
+ *        position of an offending token.
+ *
+ * @param lineIndex This parameter stores the line index of the input, or
+ *                  `nullptr` if the listener should use the positions reported
+ *                  by the parser.
+ */
+void ErrorListener::setLineIndex(LineIndex const *lineIndex) {
+  positions = lineIndex;
+}
+
+/**
+ * @brief This method sets the line number of the first line of the input.
+ *
+ * @param line This number specifies the line number of the first line.
+ */
+void ErrorListener::setFirstLine(size_t const line) {
+  skippedLines = line - 1;
+}
+
 /**
  * @brief This method will be called if the parsing process fails.
  *
@@ -25,10 +63,16 @@ using std::endl;
  *              failure.
  */
 void ErrorListener::syntaxError(Recognizer *recognizer __attribute__((unused)),
-                                Token *offendingSymbol __attribute__((unused)),
-                                size_t line, size_t charPositionInLine,
+                                Token *offendingSymbol, size_t line,
+                                size_t charPositionInLine,
                                 const std::string &message,
                                 std::exception_ptr error
                                 __attribute__((unused))) {
-  cerr << line << ":" << charPositionInLine << " " << message << endl;
+  if (positions != nullptr && offendingSymbol != nullptr &&
+      offendingSymbol->getStartIndex() != INVALID_INDEX) {
+    line = positions->line(offendingSymbol->getStartIndex());
+    charPositionInLine = positions->column(offendingSymbol->getStartIndex());
+  }
+  *output << line + skippedLines << ":" << charPositionInLine << " "
+          << message << endl;
 }
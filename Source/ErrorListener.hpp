@@ -1,20 +1,39 @@
 // -- Imports ------------------------------------------------------------------
 
+#include <iostream>
+
 #include <antlr4-runtime.h>
 
+#include "LineIndex.hpp"
+
 using antlr4::BaseErrorListener;
 using antlr4::Recognizer;
 using antlr4::Token;
 
 using std::exception_ptr;
+using std::ostream;
 using std::string;
 
 // -- Class --------------------------------------------------------------------
 
 /**
  * @brief This class specifies methods to alter error messages.
+ *
+ * If the listener has access to the line index of the lexer, then it computes
+ * the position of an error from the start index of the offending token.
  */
 class ErrorListener : public BaseErrorListener {
+  /**
+   * This variable stores the line index of the input, or `nullptr` if the
+   * listener should use the positions reported by the parser.
+   */
+  LineIndex const *positions;
+
+  /** This variable stores the stream the listener writes error messages to. */
+  ostream *output;
+
+  /** This variable stores the number of lines in front of the input. */
+  size_t skippedLines = 0;
 
   /**
    * @brief This method will be called if the parsing process fails.
@@ -34,4 +53,43 @@ class ErrorListener : public BaseErrorListener {
   void syntaxError(Recognizer *recognizer, Token *offendingSymbol, size_t line,
                    size_t charPositionInLine, const string &message,
                    exception_ptr error);
+
+public:
+  /**
+   * @brief This constructor creates a new error listener.
+   *
+   * @param lineIndex This parameter stores the line index the listener uses to
+   *                  determine the position of an offending token.
+   * @param stream This parameter stores the stream the listener writes error
+   *               messages to.
+   */
+  ErrorListener(LineIndex const *lineIndex = nullptr,
+                ostream &stream = std::cerr);
+
+  /**
+   * @brief This method sets the stream the listener writes error messages to.
+   *
+   * @param stream This parameter stores the new output stream of the listener.
+   */
+  void setOutput(ostream &stream);
+
+  /**
+   * @brief This method sets the line index the listener uses to determine the
+   *        position of an offending token.
+   *
+   * @param lineIndex This parameter stores the line index of the input, or
+   *                  `nullptr` if the listener should use the positions
+   *                  reported by the parser.
+   */
+  void setLineIndex(LineIndex const *lineIndex);
+
+  /**
+   * @brief This method sets the line number of the first line of the input.
+   *
+   * If the input is only a part of a larger text, then the listener reports
+   * positions relative to this text.
+   *
+   * @param line This number specifies the line number of the first line.
+   */
+  void setFirstLine(size_t const line);
 };
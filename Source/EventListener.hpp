@@ -0,0 +1,85 @@
+#ifndef EVENT_LISTENER_HPP
+#define EVENT_LISTENER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include "ScalarView.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class specifies the callbacks of a parser that reports the
+ *        structure of YAML data without building a parse tree.
+ *
+ * Each callback corresponds to an enter or exit method of the ANTLR listener
+ * for the grammar specified in `YAML.g4`. Instead of a rule context, the
+ * callbacks only receive the data that `KeyListener` extracts from the
+ * context. Scalars are views of the input: A listener has to copy the text, if
+ * it needs the text after the callback returns.
+ */
+class EventListener {
+public:
+  /**
+   * @brief This destructor destroys the listener.
+   */
+  virtual ~EventListener() {}
+
+  /**
+   * @brief This function will be called after the parser enters a document.
+   */
+  virtual void enterDocument() = 0;
+
+  /**
+   * @brief This function will be called after the parser exits a document.
+   */
+  virtual void exitDocument() = 0;
+
+  /**
+   * @brief This function will be called after the parser exits a value.
+   *
+   * @param text This parameter stores the text of the scalar (including
+   *             quote characters).
+   */
+  virtual void exitValue(ScalarView const &text) = 0;
+
+  /**
+   * @brief This function will be called after the parser enters a key-value
+   *        pair.
+   *
+   * @param key This parameter stores the text of the scalar that specifies
+   *            the key (including quote characters).
+   * @param hasValue This boolean specifies if the pair contains a value
+   *                 (child) after the key.
+   */
+  virtual void enterPair(ScalarView const &key, bool const hasValue) = 0;
+
+  /**
+   * @brief This function will be called after the parser exits a key-value
+   *        pair.
+   */
+  virtual void exitPair() = 0;
+
+  /**
+   * @brief This function will be called after the parser enters a sequence.
+   */
+  virtual void enterSequence() = 0;
+
+  /**
+   * @brief This function will be called after the parser exits a sequence.
+   */
+  virtual void exitSequence() = 0;
+
+  /**
+   * @brief This function will be called after the parser recognizes an element
+   *        of a sequence.
+   */
+  virtual void enterElement() = 0;
+
+  /**
+   * @brief This function will be called after the parser read an element of a
+   *        sequence.
+   */
+  virtual void exitElement() = 0;
+};
+
+#endif // EVENT_LISTENER_HPP
@@ -0,0 +1,114 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "EventParser.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parser for the given token source.
+ *
+ * @param tokens This parameter stores the token source (usually an instance of
+ *               `YAMLLexer`) the parser reads from.
+ * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+ *             token source scans. If the token indices do not specify byte
+ *             offsets of this text, then this value has to be `nullptr`.
+ */
+EventParser::EventParser(TokenSource *tokens, char const *utf8)
+    : reader{tokens, utf8} {}
+
+/**
+ * @brief This method sets the listener that receives syntax errors.
+ *
+ * @param errors This parameter stores the error listener the parser should
+ *               use.
+ */
+void EventParser::setErrorListener(ANTLRErrorListener *errors) {
+  reader.setErrorListener(errors);
+}
+
+/**
+ * @brief This method parses all tokens of the token source.
+ *
+ * @param events This parameter stores the listener that receives the parse
+ *               events.
+ *
+ * @return The number of syntax errors (`0` or `1`)
+ *
+ * @throws ParseCancellationException If the lexer is unable to tokenize the
+ *                                    input
+ */
+size_t EventParser::parse(EventListener &events) {
+  listener = &events;
+  try {
+    reader.next(); // `STREAM_START`
+    for (Event event = reader.next(); event.type != EventType::STREAM_END;
+         event = reader.next()) {
+      // The last event was `DOCUMENT_START`
+      listener->enterDocument();
+      event = reader.next();
+      if (event.type != EventType::DOCUMENT_END) {
+        parseNode(event);
+        reader.next(); // `DOCUMENT_END`
+      }
+      listener->exitDocument();
+    }
+  } catch (SyntaxErrorCancellation const &) {
+    // The reader already reported the error
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief This method reports the node that starts with the given event.
+ *
+ * @param event This parameter stores the first event of the node.
+ */
+void EventParser::parseNode(Event const &event) {
+  if (event.type == EventType::MAPPING_START) {
+    parseMapping();
+  } else if (event.type == EventType::SEQUENCE_START) {
+    parseSequence();
+  } else {
+    listener->exitValue(event.scalar);
+  }
+}
+
+/**
+ * @brief This method reports the pairs of a mapping, after the reader returned
+ *        `MAPPING_START`.
+ */
+void EventParser::parseMapping() {
+  Event event = reader.next();
+  while (event.type == EventType::KEY) {
+    // The view of the key stays valid until the reader returns the next key
+    ScalarView const key = event.scalar;
+    event = reader.next();
+
+    // If the reader returns the next key or the end of the mapping, then the
+    // current key does not have a value
+    bool const hasValue =
+        event.type != EventType::KEY && event.type != EventType::MAPPING_END;
+    listener->enterPair(key, hasValue);
+    if (hasValue) {
+      parseNode(event);
+      event = reader.next();
+    }
+    listener->exitPair();
+  }
+}
+
+/**
+ * @brief This method reports the elements of a sequence, after the reader
+ *        returned `SEQUENCE_START`.
+ */
+void EventParser::parseSequence() {
+  listener->enterSequence();
+  for (Event event = reader.next(); event.type != EventType::SEQUENCE_END;
+       event = reader.next()) {
+    listener->enterElement();
+    parseNode(event);
+    listener->exitElement();
+  }
+  listener->exitSequence();
+}
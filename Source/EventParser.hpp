@@ -0,0 +1,85 @@
+#ifndef EVENT_PARSER_HPP
+#define EVENT_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include "EventListener.hpp"
+#include "EventReader.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class parses the tokens of `YAMLLexer` and reports the structure
+ *        of the data to an `EventListener`.
+ *
+ * The parser reads the events of an `EventReader` and translates them into
+ * the callbacks `KeyListener` relies on. It does not use the ATN interpreter
+ * of ANTLR, does not buffer the token stream and does not build a parse tree.
+ *
+ * Unlike the ANTLR parser, this parser does not try to recover from syntax
+ * errors: It reports the first error and stops. The parser does not catch
+ * errors of the lexer: If the lexer is unable to tokenize the input, then
+ * `parse` passes on the exception of the lexer, so the caller can report the
+ * error.
+ */
+class EventParser {
+  /** This variable stores the reader that produces the parse events. */
+  EventReader reader;
+
+  /** This variable stores the listener that receives the parse events. */
+  EventListener *listener = nullptr;
+
+  /**
+   * @brief This method reports the node that starts with the given event.
+   *
+   * @param event This parameter stores the first event of the node.
+   */
+  void parseNode(Event const &event);
+
+  /**
+   * @brief This method reports the pairs of a mapping, after the reader
+   *        returned `MAPPING_START`.
+   */
+  void parseMapping();
+
+  /**
+   * @brief This method reports the elements of a sequence, after the reader
+   *        returned `SEQUENCE_START`.
+   */
+  void parseSequence();
+
+public:
+  /**
+   * @brief This constructor creates a new parser for the given token source.
+   *
+   * @param tokens This parameter stores the token source (usually an instance
+   *               of `YAMLLexer`) the parser reads from.
+   * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+   *             token source scans. If the token indices do not specify byte
+   *             offsets of this text, then this value has to be `nullptr`.
+   */
+  EventParser(TokenSource *tokens, char const *utf8 = nullptr);
+
+  /**
+   * @brief This method sets the listener that receives syntax errors.
+   *
+   * @param errors This parameter stores the error listener the parser
+   *               should use.
+   */
+  void setErrorListener(ANTLRErrorListener *errors);
+
+  /**
+   * @brief This method parses all tokens of the token source.
+   *
+   * @param events This parameter stores the listener that receives the
+   *               parse events.
+   *
+   * @return The number of syntax errors (`0` or `1`)
+   *
+   * @throws ParseCancellationException If the lexer is unable to tokenize
+   *                                    the input
+   */
+  size_t parse(EventListener &events);
+};
+
+#endif // EVENT_PARSER_HPP
@@ -0,0 +1,379 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "YAML.h"
+
+#include "EventReader.hpp"
+
+using antlr::YAML;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function returns the name of a token type.
+ *
+ * @param type This parameter specifies a token type of the grammar `YAML.g4`.
+ *
+ * @return The name of the token type as specified in `YAML.tokens`
+ */
+string tokenName(size_t const type) {
+  switch (type) {
+  case YAML::STREAM_START:
+    return "STREAM_START";
+  case YAML::STREAM_END:
+    return "STREAM_END";
+  case YAML::PLAIN_SCALAR:
+    return "PLAIN_SCALAR";
+  case YAML::KEY:
+    return "KEY";
+  case YAML::VALUE:
+    return "VALUE";
+  case YAML::MAPPING_START:
+    return "MAPPING_START";
+  case YAML::BLOCK_END:
+    return "BLOCK_END";
+  case YAML::ELEMENT:
+    return "ELEMENT";
+  case YAML::SEQUENCE_START:
+    return "SEQUENCE_START";
+  case YAML::DOUBLE_QUOTED_SCALAR:
+    return "DOUBLE_QUOTED_SCALAR";
+  case YAML::COMMENT:
+    return "COMMENT";
+  case YAML::SINGLE_QUOTED_SCALAR:
+    return "SINGLE_QUOTED_SCALAR";
+  case YAML::DOCUMENT_START:
+    return "DOCUMENT_START";
+  case YAML::DOCUMENT_END:
+    return "DOCUMENT_END";
+  case Token::EOF:
+    return "<EOF>";
+  }
+  return "<INVALID>";
+}
+
+/**
+ * @brief This function checks if the given token type is a scalar.
+ *
+ * @param type This parameter specifies a token type of the grammar `YAML.g4`.
+ *
+ * @retval true If `type` is the type of a scalar token
+ *         false Otherwise
+ */
+bool isScalar(size_t const type) {
+  return type == YAML::PLAIN_SCALAR || type == YAML::SINGLE_QUOTED_SCALAR ||
+         type == YAML::DOUBLE_QUOTED_SCALAR;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new reader for the given token source.
+ *
+ * @param tokens This parameter stores the token source (usually an instance of
+ *               `YAMLLexer`) the reader reads from.
+ * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+ *             token source scans. If the token indices do not specify byte
+ *             offsets of this text, then this value has to be `nullptr`.
+ */
+EventReader::EventReader(TokenSource *tokens, char const *utf8)
+    : lexer{tokens}, text{utf8} {
+  states.push(State::STREAM);
+}
+
+/**
+ * @brief This method sets the listener that receives syntax errors.
+ *
+ * @param errors This parameter stores the error listener the reader should
+ *               use.
+ */
+void EventReader::setErrorListener(ANTLRErrorListener *errors) {
+  errorListener = errors;
+}
+
+/**
+ * @brief This method reads the next event.
+ *
+ * @return The next event of the input
+ */
+Event EventReader::next() {
+  if (states.top() == State::STREAM) {
+    consume(); // Read the first token
+    match(YAML::STREAM_START);
+    states.top() = State::DOCUMENT;
+    return event(EventType::STREAM_START);
+  }
+
+  skipComments();
+  switch (states.top()) {
+  case State::DOCUMENT:
+  case State::DOCUMENT_MARKER:
+    return readDocument();
+  case State::NODE:
+    states.top() = State::DOCUMENT_END;
+    return readNode();
+  case State::OPTIONAL_NODE:
+    if (atNode()) {
+      states.top() = State::DOCUMENT_END;
+      return readNode();
+    }
+    states.top() = State::DOCUMENT_MARKER;
+    return event(EventType::DOCUMENT_END);
+  case State::DOCUMENT_END:
+    states.top() = State::DOCUMENT_MARKER;
+    return event(EventType::DOCUMENT_END);
+  case State::MAPPING_VALUE:
+    states.top() = State::MAPPING;
+    if (atNode()) {
+      return readNode();
+    }
+    return readKey(); // The last key does not have a value
+  case State::MAPPING:
+    return readKey();
+  case State::SEQUENCE:
+    return readElement();
+  case State::STREAM:
+  case State::END:
+    break;
+  }
+  return event(EventType::STREAM_END);
+}
+
+/**
+ * @brief This method skips the content of the collection the last event
+ *        started.
+ */
+void EventReader::skip() {
+  if (last != EventType::MAPPING_START && last != EventType::SEQUENCE_START) {
+    return;
+  }
+
+  size_t depth = 1;
+  while (depth > 0) {
+    EventType const type = next().type;
+    if (type == EventType::MAPPING_START || type == EventType::SEQUENCE_START) {
+      depth++;
+    } else if (type == EventType::MAPPING_END ||
+               type == EventType::SEQUENCE_END) {
+      depth--;
+    }
+  }
+}
+
+/**
+ * @brief This method returns the type of the current lookahead token.
+ *
+ * @return The token type of the current token
+ */
+size_t EventReader::type() const { return current->getType(); }
+
+/**
+ * @brief This method replaces the current lookahead token with the next token
+ *        of the token source.
+ */
+void EventReader::consume() { current = lexer->nextToken(); }
+
+/**
+ * @brief This method consumes the current token, if it has the given type.
+ *
+ * If the current token has a different type, then the method reports a syntax
+ * error and cancels the parsing process.
+ *
+ * @param expected This parameter specifies the type of the token the reader
+ *                 expects at the current position.
+ */
+void EventReader::match(size_t const expected) {
+  if (type() != expected) {
+    syntaxError(tokenName(expected));
+  }
+  if (expected != Token::EOF) {
+    consume();
+  }
+}
+
+/**
+ * @brief This method reports a syntax error at the current token and cancels
+ *        the parsing process.
+ *
+ * @param expected This text describes the input the reader expected at the
+ *                 current position.
+ */
+void EventReader::syntaxError(string const &expected) {
+  if (errorListener != nullptr) {
+    string const found =
+        type() == Token::EOF ? tokenName(Token::EOF) : current->getText();
+    errorListener->syntaxError(nullptr, current.get(), current->getLine(),
+                               current->getCharPositionInLine(),
+                               "mismatched input '" + found + "' expecting " +
+                                   expected,
+                               nullptr);
+  }
+  throw SyntaxErrorCancellation{};
+}
+
+/**
+ * @brief This method checks if the current token starts a node (a scalar, a
+ *        map or a sequence).
+ *
+ * @retval true If the current token starts a node
+ *         false Otherwise
+ */
+bool EventReader::atNode() const {
+  return isScalar(type()) || type() == YAML::MAPPING_START ||
+         type() == YAML::SEQUENCE_START;
+}
+
+/**
+ * @brief This method consumes all comment tokens at the current position.
+ */
+void EventReader::skipComments() {
+  while (type() == YAML::COMMENT) {
+    consume();
+  }
+}
+
+/**
+ * @brief This method consumes the first token of a node.
+ *
+ * @return The event for the start of the node
+ */
+Event EventReader::readNode() {
+  if (type() == YAML::MAPPING_START) {
+    consume();
+    if (type() != YAML::KEY) {
+      syntaxError(tokenName(YAML::KEY));
+    }
+    states.push(State::MAPPING);
+    return event(EventType::MAPPING_START);
+  }
+  if (type() == YAML::SEQUENCE_START) {
+    consume();
+    if (type() != YAML::ELEMENT) {
+      syntaxError(tokenName(YAML::ELEMENT));
+    }
+    states.push(State::SEQUENCE);
+    return event(EventType::SEQUENCE_START);
+  }
+  if (!isScalar(type())) {
+    syntaxError("{PLAIN_SCALAR, DOUBLE_QUOTED_SCALAR, SINGLE_QUOTED_SCALAR, "
+                "MAPPING_START, SEQUENCE_START}");
+  }
+  return readScalar(EventType::SCALAR);
+}
+
+/**
+ * @brief This method consumes the next key of a mapping, or the end of the
+ *        mapping.
+ *
+ * @return A `KEY` or `MAPPING_END` event
+ */
+Event EventReader::readKey() {
+  if (type() != YAML::KEY) {
+    match(YAML::BLOCK_END);
+    states.pop();
+    return event(EventType::MAPPING_END);
+  }
+
+  consume();
+  if (!isScalar(type())) {
+    syntaxError("{PLAIN_SCALAR, DOUBLE_QUOTED_SCALAR, SINGLE_QUOTED_SCALAR}");
+  }
+  Event key = readScalar(EventType::KEY);
+  match(YAML::VALUE);
+  states.top() = State::MAPPING_VALUE;
+  return key;
+}
+
+/**
+ * @brief This method consumes the start of the next element of a sequence, or
+ *        the end of the sequence.
+ *
+ * @return The event for the start of the element, or `SEQUENCE_END`
+ */
+Event EventReader::readElement() {
+  if (type() != YAML::ELEMENT) {
+    match(YAML::BLOCK_END);
+    states.pop();
+    return event(EventType::SEQUENCE_END);
+  }
+
+  consume();
+  skipComments();
+  return readNode();
+}
+
+/**
+ * @brief This method consumes the start of the next document, or the end of
+ *        the stream.
+ *
+ * @return A `DOCUMENT_START` or `STREAM_END` event
+ */
+Event EventReader::readDocument() {
+  // After a document end marker the next document does not need a start
+  // marker
+  while (type() == YAML::DOCUMENT_END) {
+    consume();
+    skipComments();
+    states.top() = State::DOCUMENT;
+  }
+
+  if (states.top() == State::DOCUMENT && atNode()) {
+    states.top() = State::NODE;
+    return event(EventType::DOCUMENT_START);
+  }
+  if (type() != YAML::DOCUMENT_START) {
+    return readStreamEnd();
+  }
+  consume();
+  states.top() = State::OPTIONAL_NODE;
+  return event(EventType::DOCUMENT_START);
+}
+
+/**
+ * @brief This method consumes the end of the stream.
+ *
+ * @return A `STREAM_END` event
+ */
+Event EventReader::readStreamEnd() {
+  match(YAML::STREAM_END);
+  match(Token::EOF);
+  states.top() = State::END;
+  return event(EventType::STREAM_END);
+}
+
+/**
+ * @brief This method consumes the current scalar token.
+ *
+ * @param type This parameter specifies the type of the returned event.
+ *
+ * @return An event of type `type` that stores a view of the scalar
+ */
+Event EventReader::readScalar(EventType const type) {
+  Event scalarEvent = event(type);
+  if (text != nullptr) {
+    scalarEvent.scalar =
+        ScalarView{text + current->getStartIndex(),
+                   current->getStopIndex() - current->getStartIndex() + 1};
+  } else {
+    string &storage = type == EventType::KEY ? keyText : scalarText;
+    storage = current->getText();
+    scalarEvent.scalar = ScalarView{storage};
+  }
+  consume();
+  return scalarEvent;
+}
+
+/**
+ * @brief This method creates an event that does not store a scalar.
+ *
+ * @param type This parameter specifies the type of the returned event.
+ *
+ * @return An event of type `type`
+ */
+Event EventReader::event(EventType const type) {
+  last = type;
+  return Event{type, ScalarView{}};
+}
@@ -0,0 +1,297 @@
+#ifndef EVENT_READER_HPP
+#define EVENT_READER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <stack>
+
+#include <antlr4-runtime.h>
+
+#include "ScalarView.hpp"
+
+using std::size_t;
+using std::stack;
+using std::string;
+using std::unique_ptr;
+
+using antlr4::ANTLRErrorListener;
+using antlr4::ParseCancellationException;
+using antlr4::Token;
+using antlr4::TokenSource;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration lists the types of events an `EventReader` produces. */
+enum class EventType {
+  STREAM_START,
+  STREAM_END,
+  DOCUMENT_START,
+  DOCUMENT_END,
+  MAPPING_START,
+  MAPPING_END,
+  SEQUENCE_START,
+  SEQUENCE_END,
+  KEY,
+  SCALAR
+};
+
+/**
+ * @brief This structure stores a single parse event.
+ *
+ * Events of type `KEY` and `SCALAR` store a view of the scalar text
+ * (including quote characters). For all other events the view is empty.
+ */
+struct Event {
+  /** This variable specifies the type of the event. */
+  EventType type;
+
+  /** This variable stores the text of a key or scalar. */
+  ScalarView scalar;
+};
+
+/**
+ * @brief The event reader throws this exception after it reported a syntax
+ *        error.
+ *
+ * The lexer throws a plain `ParseCancellationException`, if it is unable to
+ * tokenize the input. This way the user of the reader can tell both cases
+ * apart.
+ */
+class SyntaxErrorCancellation : public ParseCancellationException {
+public:
+  using ParseCancellationException::ParseCancellationException;
+};
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class reads the tokens of `YAMLLexer` and returns the structure
+ *        of the data as a sequence of events.
+ *
+ * In contrast to a parser that calls a listener, the reader only does work,
+ * when its user asks for the next event. A user can therefore stop reading
+ * at any point, or skip a whole collection without looking at its content.
+ * The reader recognizes the same language as the grammar `YAML.g4`.
+ *
+ * If the reader knows the text the lexer scans, then scalar events point
+ * directly into this text and stay valid as long as the text exists.
+ * Otherwise the reader copies the text of each scalar into an internal
+ * buffer. The view of a `SCALAR` event then stays valid until the next call
+ * of `next`, and the view of a `KEY` event until the reader returns the next
+ * key. This way a user can still access a key, after it read the value of
+ * the key.
+ *
+ * The reader cancels the parsing process with a `SyntaxErrorCancellation`
+ * after it reports the first syntax error. The lexer cancels the parsing
+ * process with a `ParseCancellationException`, if it is unable to tokenize
+ * the input.
+ */
+class EventReader {
+  /** This enumeration lists the states of the reader. */
+  enum class State {
+    /** The reader did not read `STREAM START` yet. */
+    STREAM,
+    /**
+     * The reader expects a document (with or without start marker), a
+     * document marker or `STREAM END`.
+     */
+    DOCUMENT,
+    /** The reader read a document and expects a marker or `STREAM END`. */
+    DOCUMENT_MARKER,
+    /** The reader started a document without marker and expects its node. */
+    NODE,
+    /** The reader read a document start marker and expects an optional node. */
+    OPTIONAL_NODE,
+    /** The reader read the top level node of a document. */
+    DOCUMENT_END,
+    /** The reader expects a key or the end of a mapping. */
+    MAPPING,
+    /** The reader read a key and expects its value. */
+    MAPPING_VALUE,
+    /** The reader expects an element or the end of a sequence. */
+    SEQUENCE,
+    /** The reader read `STREAM END`. */
+    END
+  };
+
+  /** This variable stores the token source this reader reads from. */
+  TokenSource *lexer;
+
+  /**
+   * This pointer stores the UTF-8 text the lexer scans, or `nullptr` if the
+   * token indices do not refer to bytes of a buffer.
+   */
+  char const *text;
+
+  /** This variable stores the current lookahead token. */
+  unique_ptr<Token> current;
+
+  /**
+   * This stack stores the states of all collections the reader entered and
+   * the state of the document on the bottom.
+   */
+  stack<State> states;
+
+  /** This string stores the text of the last key, if `text` is empty. */
+  string keyText;
+
+  /** This string stores the text of the last scalar, if `text` is empty. */
+  string scalarText;
+
+  /** This variable stores the type of the last event. */
+  EventType last = EventType::STREAM_START;
+
+  /**
+   * This variable stores the listener that receives syntax errors, or
+   * `nullptr` if the reader should not report errors.
+   */
+  ANTLRErrorListener *errorListener = nullptr;
+
+  /**
+   * @brief This method returns the type of the current lookahead token.
+   *
+   * @return The token type of the current token
+   */
+  size_t type() const;
+
+  /**
+   * @brief This method replaces the current lookahead token with the next
+   *        token of the token source.
+   */
+  void consume();
+
+  /**
+   * @brief This method consumes the current token, if it has the given type.
+   *
+   * If the current token has a different type, then the method reports a
+   * syntax error and cancels the parsing process.
+   *
+   * @param expected This parameter specifies the type of the token the reader
+   *                 expects at the current position.
+   */
+  void match(size_t const expected);
+
+  /**
+   * @brief This method reports a syntax error at the current token and
+   *        cancels the parsing process.
+   *
+   * @param expected This text describes the input the reader expected at the
+   *                 current position.
+   */
+  void syntaxError(string const &expected);
+
+  /**
+   * @brief This method checks if the current token starts a node (a scalar, a
+   *        map or a sequence).
+   *
+   * @retval true If the current token starts a node
+   *         false Otherwise
+   */
+  bool atNode() const;
+
+  /**
+   * @brief This method consumes all comment tokens at the current position.
+   */
+  void skipComments();
+
+  /**
+   * @brief This method consumes the first token of a node.
+   *
+   * @return The event for the start of the node
+   */
+  Event readNode();
+
+  /**
+   * @brief This method consumes the next key of a mapping, or the end of the
+   *        mapping.
+   *
+   * @return A `KEY` or `MAPPING_END` event
+   */
+  Event readKey();
+
+  /**
+   * @brief This method consumes the start of the next element of a sequence,
+   *        or the end of the sequence.
+   *
+   * @return The event for the start of the element, or `SEQUENCE_END`
+   */
+  Event readElement();
+
+  /**
+   * @brief This method consumes the start of the next document, or the end of
+   *        the stream.
+   *
+   * @return A `DOCUMENT_START` or `STREAM_END` event
+   */
+  Event readDocument();
+
+  /**
+   * @brief This method consumes the end of the stream.
+   *
+   * @return A `STREAM_END` event
+   */
+  Event readStreamEnd();
+
+  /**
+   * @brief This method consumes the current scalar token.
+   *
+   * @param type This parameter specifies the type of the returned event.
+   *
+   * @return An event of type `type` that stores a view of the scalar
+   */
+  Event readScalar(EventType const type);
+
+  /**
+   * @brief This method creates an event that does not store a scalar.
+   *
+   * @param type This parameter specifies the type of the returned event.
+   *
+   * @return An event of type `type`
+   */
+  Event event(EventType const type);
+
+public:
+  /**
+   * @brief This constructor creates a new reader for the given token source.
+   *
+   * @param tokens This parameter stores the token source (usually an instance
+   *               of `YAMLLexer`) the reader reads from.
+   * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+   *             token source scans. If the token indices do not specify byte
+   *             offsets of this text, then this value has to be `nullptr`.
+   */
+  EventReader(TokenSource *tokens, char const *utf8 = nullptr);
+
+  /**
+   * @brief This method sets the listener that receives syntax errors.
+   *
+   * @param errors This parameter stores the error listener the reader
+   *               should use.
+   */
+  void setErrorListener(ANTLRErrorListener *errors);
+
+  /**
+   * @brief This method reads the next event.
+   *
+   * The reader surrounds the events of each document with `DOCUMENT_START`
+   * and `DOCUMENT_END`, even if the input does not contain any document
+   * markers. An empty document (a start marker without a node) produces only
+   * these two events. After the reader returned `STREAM_END`, every further
+   * call returns `STREAM_END` again.
+   *
+   * @return The next event of the input
+   */
+  Event next();
+
+  /**
+   * @brief This method skips the content of the collection the last event
+   *        started.
+   *
+   * If the last event was `MAPPING_START` or `SEQUENCE_START`, then the
+   * method reads all events up to and including the matching end event.
+   * Otherwise the method does nothing.
+   */
+  void skip();
+};
+
+#endif // EVENT_READER_HPP
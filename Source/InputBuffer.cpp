@@ -0,0 +1,125 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "InputBuffer.hpp"
+
+using std::generic_category;
+using std::system_error;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor provides access to the content of the given file.
+ *
+ * @param filename This parameter specifies the location of the file. The
+ *                 value `-` specifies the standard input.
+ *
+ * @throws std::system_error If the constructor is unable to read the file
+ */
+InputBuffer::InputBuffer(string const &filename) {
+  bool const standardInput = filename == "-";
+  int const descriptor =
+      standardInput ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw system_error(errno, generic_category(),
+                       "Unable to open file “" + filename + "”");
+  }
+
+  struct stat status;
+  if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) &&
+      status.st_size > 0) {
+    size_t const size = static_cast<size_t>(status.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping != MAP_FAILED) {
+      // The lexer reads the input from the start to the end
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      data = static_cast<char const *>(mapping);
+      length = size;
+      mapped = true;
+    }
+  }
+
+  try {
+    if (!mapped) {
+      readAll(descriptor);
+    }
+  } catch (system_error const &error) {
+    if (!standardInput) {
+      close(descriptor);
+    }
+    throw system_error(error.code(), "Unable to read file “" + filename + "”");
+  }
+
+  // A memory mapping stays valid after we close the file descriptor
+  if (!standardInput) {
+    close(descriptor);
+  }
+}
+
+/**
+ * @brief This destructor releases the memory used to store the file content.
+ */
+InputBuffer::~InputBuffer() {
+  if (mapped) {
+    munmap(const_cast<char *>(data), length);
+  }
+}
+
+/**
+ * @brief This method returns the start of the file content.
+ *
+ * @return A pointer to the first byte of the file content
+ */
+char const *InputBuffer::begin() const { return data; }
+
+/**
+ * @brief This method returns the size of the file content.
+ *
+ * @return The number of bytes stored in the file
+ */
+size_t InputBuffer::size() const { return length; }
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method reads the remaining data of the given file descriptor
+ *        into `buffer`.
+ *
+ * @param descriptor This parameter specifies the file descriptor this function
+ *                   reads from.
+ */
+void InputBuffer::readAll(int const descriptor) {
+  size_t used = 0;
+  buffer.resize(64 * 1024);
+
+  while (true) {
+    if (used == buffer.size()) {
+      buffer.resize(2 * buffer.size());
+    }
+    ssize_t const bytes =
+        ::read(descriptor, &buffer[used], buffer.size() - used);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes < 0) {
+      throw system_error(errno, generic_category());
+    }
+    if (bytes == 0) {
+      break;
+    }
+    used += static_cast<size_t>(bytes);
+  }
+
+  buffer.resize(used);
+  data = buffer.data();
+  length = buffer.size();
+}
@@ -0,0 +1,80 @@
+#ifndef INPUT_BUFFER_HPP
+#define INPUT_BUFFER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <string>
+
+using std::string;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides read-only access to the content of a file.
+ *
+ * If the file is a regular file, then the class maps the file into memory.
+ * This way the lexer can read the data directly from the page cache, without
+ * copying it into the heap first. For other input sources, such as pipes or
+ * the standard input, the class reads the whole input into a single buffer.
+ */
+class InputBuffer {
+  /** This pointer stores the start of the file content. */
+  char const *data = "";
+
+  /** This variable stores the size of the file content in bytes. */
+  size_t length = 0;
+
+  /**
+   * This variable specifies if `data` points to a memory mapping (`true`) or
+   * into `buffer` (`false`).
+   */
+  bool mapped = false;
+
+  /** This variable stores the content of input sources we can not map. */
+  string buffer;
+
+  /**
+   * @brief This method reads the remaining data of the given file descriptor
+   *        into `buffer`.
+   *
+   * @param descriptor This parameter specifies the file descriptor this
+   *                   function reads from.
+   */
+  void readAll(int const descriptor);
+
+public:
+  /**
+   * @brief This constructor provides access to the content of the given file.
+   *
+   * @param filename This parameter specifies the location of the file. The
+   *                 value `-` specifies the standard input.
+   *
+   * @throws std::system_error If the constructor is unable to read the file
+   */
+  InputBuffer(string const &filename);
+
+  /**
+   * @brief This destructor releases the memory used to store the file
+   *        content.
+   */
+  ~InputBuffer();
+
+  InputBuffer(InputBuffer const &) = delete;
+  InputBuffer &operator=(InputBuffer const &) = delete;
+
+  /**
+   * @brief This method returns the start of the file content.
+   *
+   * @return A pointer to the first byte of the file content
+   */
+  char const *begin() const;
+
+  /**
+   * @brief This method returns the size of the file content.
+   *
+   * @return The number of bytes stored in the file
+   */
+  size_t size() const;
+};
+
+#endif // INPUT_BUFFER_HPP
@@ -0,0 +1,81 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "LineIndex.hpp"
+#include "ScanKernels.hpp"
+
+using std::upper_bound;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new line index.
+ *
+ * @param utf8 This pointer stores the start of the UTF-8 encoded text, whose
+ *             byte offsets the index maps. If indices count code points,
+ *             then this value has to be `nullptr`.
+ */
+LineIndex::LineIndex(char const *utf8) : text{utf8} {}
+
+/**
+ * @brief This method returns the line that contains the given position.
+ *
+ * @param index This number specifies a position inside the input.
+ *
+ * @return The line number (starting with `1`) of `index`
+ */
+size_t LineIndex::line(size_t const index) const {
+  auto const next = upper_bound(starts.begin(), starts.end(), index);
+  return forgotten + static_cast<size_t>(next - starts.begin());
+}
+
+/**
+ * @brief This method removes all lines in front of the given position from
+ *        the index.
+ *
+ * @param index This number specifies a position inside the input. The method
+ *              keeps the line that contains this position and all lines
+ *              behind it.
+ */
+void LineIndex::forget(size_t const index) {
+  size_t const count = line(index) - forgotten - 1;
+  // Removing the first lines moves all other lines. We therefore only remove
+  // lines, if they make up at least half of the index.
+  if (count == 0 || count < starts.size() / 2) {
+    return;
+  }
+  starts.erase(starts.begin(), starts.begin() + static_cast<ssize_t>(count));
+  forgotten += count;
+}
+
+/**
+ * @brief This method returns the column of the given position.
+ *
+ * @param index This number specifies a position inside the input.
+ *
+ * @return The column (starting with `1`) of `index`
+ */
+size_t LineIndex::column(size_t const index) const {
+  return countColumns(starts[line(index) - forgotten - 1], index) + 1;
+}
+
+/**
+ * @brief This method counts the columns between two positions in the same
+ *        line.
+ *
+ * @param start This number specifies the first position of the range.
+ * @param stop This number specifies the position after the last character of
+ *             the range.
+ *
+ * @return The number of characters in the range
+ */
+size_t LineIndex::countColumns(size_t const start, size_t const stop) const {
+  if (stop <= start) {
+    return 0;
+  }
+  if (text == nullptr) {
+    return stop - start;
+  }
+  return countCodePoints(text + start, stop - start);
+}
@@ -0,0 +1,134 @@
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <vector>
+
+using std::size_t;
+using std::vector;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class maps indices of an input stream to line and column
+ *        numbers.
+ *
+ * The index only stores the start offset of each line. A lexer adds the
+ * start of a new line, whenever it consumes a newline character. Line and
+ * column of a position are computed, only if someone requests them.
+ *
+ * Indices either count code points (like `ANTLRInputStream`) or bytes of
+ * UTF-8 encoded text (like `BufferStream`). In the second case the index
+ * needs access to the text to determine the column of a position, since a
+ * column contains one code point, not one byte.
+ *
+ * If the lexer reads its input through a sliding window (`ChunkStream`), then
+ * it also tells the index which lines it does not need any more. The index
+ * then removes the start of these lines, but still reports the same line
+ * numbers for all other positions.
+ */
+class LineIndex {
+  /**
+   * This vector stores the start index of each line. The first line always
+   * starts at index `0`.
+   */
+  vector<size_t> starts{0};
+
+  /** This number stores the number of lines removed from `starts`. */
+  size_t forgotten = 0;
+
+  /**
+   * This pointer stores the UTF-8 text the indices refer to, or `nullptr` if
+   * indices count code points.
+   */
+  char const *text;
+
+public:
+  /**
+   * @brief This constructor creates a new line index.
+   *
+   * @param utf8 This pointer stores the start of the UTF-8 encoded text,
+   *             whose byte offsets the index maps. If indices count code
+   *             points, then this value has to be `nullptr`.
+   */
+  LineIndex(char const *utf8 = nullptr);
+
+  /**
+   * @brief This method adds the start of a new line to the index.
+   *
+   * @param start This number specifies the index of the first character
+   *              after a newline character. The value has to be larger than
+   *              the start of all lines already stored in the index.
+   */
+  void addLine(size_t const start);
+
+  /**
+   * @brief This method removes all lines in front of the given position from
+   *        the index.
+   *
+   * Afterwards the index does not know the line and column of positions in
+   * the removed lines any more.
+   *
+   * @param index This number specifies a position inside the input. The
+   *              method keeps the line that contains this position and all
+   *              lines behind it.
+   */
+  void forget(size_t const index);
+
+  /**
+   * @brief This method returns the number of lines the index knows about.
+   *
+   * @return The number of the last line stored in the index
+   */
+  size_t lines() const;
+
+  /**
+   * @brief This method returns the start index of the last line stored in
+   *        the index.
+   *
+   * @return The index of the first character in the last known line
+   */
+  size_t lastLineStart() const;
+
+  /**
+   * @brief This method returns the line that contains the given position.
+   *
+   * @param index This number specifies a position inside the input.
+   *
+   * @return The line number (starting with `1`) of `index`
+   */
+  size_t line(size_t const index) const;
+
+  /**
+   * @brief This method returns the column of the given position.
+   *
+   * @param index This number specifies a position inside the input.
+   *
+   * @return The column (starting with `1`) of `index`
+   */
+  size_t column(size_t const index) const;
+
+  /**
+   * @brief This method counts the columns between two positions in the same
+   *        line.
+   *
+   * @param start This number specifies the first position of the range.
+   * @param stop This number specifies the position after the last character
+   *             of the range.
+   *
+   * @return The number of characters in the range
+   */
+  size_t countColumns(size_t const start, size_t const stop) const;
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline void LineIndex::addLine(size_t const start) { starts.push_back(start); }
+
+inline size_t LineIndex::lines() const { return forgotten + starts.size(); }
+
+inline size_t LineIndex::lastLineStart() const { return starts.back(); }
+
+#endif // LINE_INDEX_HPP
@@ -1,48 +1,73 @@
 // -- Imports ------------------------------------------------------------------
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 #include "Listener.hpp"
+#include "ScalarDecoder.hpp"
+
+using std::fill_n;
+using std::numeric_limits;
+using std::runtime_error;
+using std::stable_sort;
 
 // -- Functions ----------------------------------------------------------------
 
 namespace {
 
+/** This string stores the initial name of the escaper of `KeyListener`. */
+char const ESCAPER_NAME[] = "user/escaped";
+
+/** The escaped base name of the escaper starts after this number of bytes. */
+size_t const ESCAPER_PREFIX = sizeof("user/") - 1;
+
 /**
- * @brief This function converts a given number to an array base name.
+ * This number specifies the maximum length of an array base name: a `#`
+ * followed by an underscore for all but the last digit of the index.
+ */
+size_t const ARRAY_BASE_NAME_SIZE =
+    1 + 2 * numeric_limits<uintmax_t>::digits10 + 1;
+
+/**
+ * @brief This function writes the array base name for an index into a
+ *        buffer.
  *
  * @param index This number specifies the index of the array entry.
+ * @param buffer This parameter stores the buffer this function writes to.
  *
- * @return A string representing the given indices as Elektra array name.
+ * @return A view of the Elektra array name for `index` inside `buffer`
  */
-string indexToArrayBaseName(uintmax_t const index) {
-  size_t digits = 1;
-
-  for (uintmax_t value = index; value > 9; digits++) {
-    value /= 10;
-  }
+ScalarView formatArrayBaseName(uintmax_t index,
+                               char (&buffer)[ARRAY_BASE_NAME_SIZE]) {
+  // We write the digits backwards from the end of the buffer
+  char *start = buffer + ARRAY_BASE_NAME_SIZE;
+  do {
+    *--start = static_cast<char>('0' + index % 10);
+    index /= 10;
+  } while (index > 0);
 
-  return "#" + string(digits - 1, '_') + to_string(index);
+  size_t const digits = buffer + ARRAY_BASE_NAME_SIZE - start;
+  start -= digits;
+  *start = '#';
+  fill_n(start + 1, digits - 1, '_');
+  return ScalarView{start, 2 * digits};
 }
 
+} // namespace
+
 /**
- * @brief This function converts a YAML scalar to a string.
+ * @brief This function returns the Elektra array base name for an index.
  *
- * @param text This string contains a YAML scalar (including quote
- *             characters).
+ * @param index This number specifies the index of the array entry.
  *
- * @return A string without leading and trailing quote characters
+ * @return The base name of the array entry with index `index`
  */
-string scalarToText(string const &text) {
-  if (text.length() == 0) {
-    return text;
-  }
-  if (*(text.begin()) == '"' || *(text.begin()) == '\'') {
-    return text.substr(1, text.length() - 2);
-  }
-  return text;
+string arrayBaseName(uintmax_t const index) {
+  char arrayName[ARRAY_BASE_NAME_SIZE];
+  return formatArrayBaseName(index, arrayName).str();
 }
 
-} // namespace
-
 // -- Class --------------------------------------------------------------------
 
 /**
@@ -51,15 +76,285 @@ string scalarToText(string const &text) {
  *
  * @param parent This key specifies the parent of all keys stored in the
  *               object.
+ * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+ *             lexer scans. If the token indices do not specify byte offsets
+ *             of this text, then this value has to be `nullptr`.
  */
-KeyListener::KeyListener(CppKey parent) : keys{} { parents.push(parent); }
+KeyListener::KeyListener(CppKey parent, char const *utf8)
+    : keys{}, original{parent.dup()}, name{parent.getName()},
+      escaper{ESCAPER_NAME, KEY_END}, input{utf8} {
+  parents.push(parent);
+}
 
 /**
  * @brief This function returns the data read by the parser.
  *
+ * If the listener has a consumer, then the result only contains the keys the
+ * listener did not pass on yet.
+ *
  * @return The key set representing the data from the textual input
  */
-CppKeySet KeyListener::keySet() { return keys; }
+CppKeySet KeyListener::keySet() {
+  // A stable sort keeps the order of keys with the same name. The key set
+  // then stores the last of these keys, like it did for single insertions.
+  stable_sort(keys.begin(), keys.end());
+
+  CppKeySet sorted{keys.size(), KS_END};
+  for (auto const &key : keys) {
+    sorted.append(key);
+  }
+  return sorted;
+}
+
+/**
+ * @brief This method makes the listener pass its keys to a consumer in
+ *        batches.
+ *
+ * @param receiver This function receives each batch of keys as a sorted key
+ *                 set.
+ * @param size This number specifies the number of keys in a batch.
+ */
+void KeyListener::setConsumer(function<void(CppKeySet &)> receiver,
+                              size_t const size) {
+  consumer = receiver;
+  batchSize = size > 0 ? size : 1;
+  keys.reserve(batchSize);
+}
+
+/**
+ * @brief This method passes all keys the listener did not pass on yet to the
+ *        consumer.
+ */
+void KeyListener::flush() {
+  if (!consumer || keys.empty()) {
+    return;
+  }
+  CppKeySet batch = keySet();
+  keys.clear();
+  if (batches < UINTMAX_MAX) {
+    batches++;
+  }
+  consumer(batch);
+}
+
+/**
+ * @brief This method tells the listener to store the keys of every document
+ *        below the array base name of the document.
+ *
+ * Usually the listener stores the keys of a stream with a single document
+ * directly below the parent. After this call it stores them below
+ * `parent/#0` instead. This way the listener never has to move the keys of
+ * the first document, which might have reached the consumer already.
+ */
+void KeyListener::nestAllDocuments() { alwaysNest = true; }
+
+/**
+ * @brief This method returns the text of a scalar token.
+ *
+ * @param token This parameter stores the scalar token.
+ * @param storage This string stores a copy of the text, if the listener does
+ *                not know the input of the lexer.
+ *
+ * @return A view of the text of `token` (including quote characters)
+ */
+ScalarView KeyListener::scalar(Token *token, string &storage) const {
+  if (input != nullptr) {
+    return ScalarView{input + token->getStartIndex(),
+                      token->getStopIndex() - token->getStartIndex() + 1};
+  }
+  storage = token->getText();
+  return ScalarView{storage};
+}
+
+/**
+ * @brief This method decodes the content of a scalar into `buffer`.
+ *
+ * @param text This parameter stores the text of the scalar (including quote
+ *             characters).
+ *
+ * @return The null terminated content of the scalar
+ */
+char const *KeyListener::decode(ScalarView const &text) {
+  decodeScalar(text, buffer);
+  return buffer.c_str();
+}
+
+/**
+ * @brief This method escapes a base name.
+ *
+ * @param baseName This parameter stores the unescaped base name.
+ *
+ * @return A view of the escaped base name, which stays valid until the next
+ *         call of this method
+ */
+ScalarView KeyListener::escape(char const *baseName) {
+  // We let Elektra escape the base name below a short parent. This way the
+  // listener uses the same rules as `keyAddBaseName`, without copying the
+  // whole name of the parent.
+  ckdb::Key *key = escaper.getKey();
+  ckdb::keySetBaseName(key, baseName);
+  size_t const size = static_cast<size_t>(ckdb::keyGetNameSize(key)) - 1;
+  return ScalarView{ckdb::keyName(key) + ESCAPER_PREFIX,
+                    size - ESCAPER_PREFIX};
+}
+
+/**
+ * @brief This method adds a key to the result.
+ *
+ * @param key This parameter stores the key this method adds.
+ */
+void KeyListener::addKey(CppKey const &key) {
+  emptyDocument = false;
+  keys.push_back(key);
+  if (consumer && keys.size() >= batchSize) {
+    flush();
+  }
+}
+
+/**
+ * @brief This method adds a key below the key on top of `parents`.
+ *
+ * @param baseName This parameter stores the escaped base name of the new key.
+ *
+ * @return The new key
+ */
+CppKey KeyListener::pushKey(ScalarView const &baseName) {
+  lengths.push(name.size());
+  name += '/';
+  name.append(baseName.data(), baseName.size());
+  CppKey key{name.c_str(), KEY_END};
+  parents.push(key);
+  return key;
+}
+
+/**
+ * @brief This method removes the key on top of `parents`.
+ */
+void KeyListener::popKey() {
+  parents.pop();
+  name.resize(lengths.top());
+  lengths.pop();
+}
+
+/**
+ * @brief This method moves the keys of the first document below the array
+ *        base name `#0`.
+ *
+ * The listener only knows that a stream contains multiple documents, after
+ * the parser entered the second document. Until then it stores the keys of
+ * the first document directly below the parent.
+ *
+ * @throws std::runtime_error If the listener already passed keys of the first
+ *                            document to its consumer
+ */
+void KeyListener::nestFirstDocument() {
+  if (batches > 0) {
+    throw runtime_error{"Unable to move the keys of the first document below "
+                        "“#0”, since the listener already passed them on"};
+  }
+
+  string const prefix = name + "/" + arrayBaseName(0);
+  for (auto &key : keys) {
+    CppKey nested = key.dup();
+    string const suffix = key.getName().substr(name.size());
+    ckdb::keySetName(nested.getKey(), (prefix + suffix).c_str());
+    key = nested;
+  }
+  if (emptyDocument) {
+    // Like every other empty document, the first one adds a key without value
+    addKey(CppKey{prefix.c_str(), KEY_END});
+  }
+
+  // The first document might have changed the value or metadata of the
+  // parent key
+  parents.pop();
+  parents.push(original.dup());
+  addKey(parents.top());
+}
+
+/**
+ * @brief This function will be called after the parser enters a document
+ *        without start marker.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterBareDocument(BareDocumentContext *context
+                                    __attribute__((unused))) {
+  enterDocument();
+}
+
+/**
+ * @brief This function will be called after the parser exits a document
+ *        without start marker.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::exitBareDocument(BareDocumentContext *context
+                                   __attribute__((unused))) {
+  exitDocument();
+}
+
+/**
+ * @brief This function will be called after the parser enters a document
+ *        with start marker.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterExplicitDocument(ExplicitDocumentContext *context
+                                        __attribute__((unused))) {
+  enterDocument();
+}
+
+/**
+ * @brief This function will be called after the parser exits a document
+ *        with start marker.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::exitExplicitDocument(ExplicitDocumentContext *context
+                                       __attribute__((unused))) {
+  exitDocument();
+}
+
+/**
+ * @brief This function will be called after the parser enters a document.
+ */
+void KeyListener::enterDocument() {
+  if (documents == 1 && !alwaysNest) {
+    nestFirstDocument();
+  }
+  if (documents > 0 || alwaysNest) {
+    // Like for a sequence, the metadata `array` of the parent stores the base
+    // name of the last document
+    string const baseName = arrayBaseName(documents);
+    parents.top().setMeta("array", baseName);
+    if (documents == 0 || batches > 0) {
+      // The result has to contain the parent of the first document. Later
+      // the consumer might have received the parent with an old value of the
+      // metadata already.
+      addKey(parents.top());
+    }
+    pushKey(ScalarView{baseName});
+  }
+  if (documents < UINTMAX_MAX) {
+    documents++;
+  }
+  emptyDocument = true;
+}
+
+/**
+ * @brief This function will be called after the parser exits a document.
+ */
+void KeyListener::exitDocument() {
+  if (documents > 1 || alwaysNest) {
+    if (emptyDocument) {
+      // Add the key of the document with an empty value, so the array does
+      // not contain a hole
+      addKey(parents.top());
+    }
+    popKey(); // Remove the key for the current document
+  }
+}
 
 /**
  * @brief This function will be called after the parser exits a value.
@@ -67,26 +362,39 @@ CppKeySet KeyListener::keySet() { return keys; }
  * @param context The context specifies data matched by the rule.
  */
 void KeyListener::exitValue(ValueContext *context) {
+  // A value consists of a single scalar token
+  string text;
+  exitValue(scalar(context->getStart(), text));
+}
+
+/**
+ * @brief This function will be called after the parser exits a value.
+ *
+ * @param text This parameter stores the text of the scalar (including quote
+ *             characters).
+ */
+void KeyListener::exitValue(ScalarView const &text) {
   CppKey key = parents.top();
-  key.setString(scalarToText(context->getText()));
-  keys.append(key);
+  ckdb::keySetString(key.getKey(), decode(text));
+  addKey(key);
 }
 
 /**
  * @brief This function will be called after the parser enters a key-value pair.
  *
- * @param context The context specifies data matched by the rule.
+ * @param key This parameter stores the text of the scalar that specifies the
+ *            key (including quote characters).
+ * @param hasValue This boolean specifies if the pair contains a value (child)
+ *                 after the key.
  */
-void KeyListener::enterPair(PairContext *context) {
+void KeyListener::enterPair(ScalarView const &key, bool const hasValue) {
   // Entering a mapping such as `part: …` means that we need to add `part` to
   // the key name
-  CppKey child{parents.top().getName(), KEY_END};
-  child.addBaseName(scalarToText(context->key()->getText()));
-  parents.push(child);
-  if (!context->child()) {
+  CppKey child = pushKey(escape(decode(key)));
+  if (!hasValue) {
     // Add key with empty value
     // The parser does not visit `exitValue` in that case
-    keys.append(child);
+    addKey(child);
   }
 }
 
@@ -96,9 +404,47 @@ void KeyListener::enterPair(PairContext *context) {
  * @param context The context specifies data matched by the rule.
  */
 void KeyListener::exitPair(PairContext *context __attribute__((unused))) {
+  if (keyPending) {
+    // The parser did not enter a child after the key
+    keyPending = false;
+    enterPair(pendingKey, false);
+  }
+  exitPair();
+}
+
+/**
+ * @brief This function will be called after the parser exits the key of a
+ *        key-value pair.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::exitKey(KeyContext *context) {
+  // A key consists of a single scalar token
+  pendingKey = scalar(context->getStart(), pendingKeyText);
+  keyPending = true;
+}
+
+/**
+ * @brief This function will be called after the parser enters a child (value,
+ *        map or sequence).
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterChild(ChildContext *context __attribute__((unused))) {
+  if (keyPending) {
+    // The child is the value of the last key
+    keyPending = false;
+    enterPair(pendingKey, true);
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits a key-value pair.
+ */
+void KeyListener::exitPair() {
   // Returning from a mapping such as `part: …` means that we need need to
   // remove the key for `part` from the stack.
-  parents.pop();
+  popKey();
 }
 
 /**
@@ -108,10 +454,14 @@ void KeyListener::exitPair(PairContext *context __attribute__((unused))) {
  */
 void KeyListener::enterSequence(SequenceContext *context
                                 __attribute__((unused))) {
-  indices.push(0);
-  parents.top().setMeta("array", ""); // We start with an empty array
+  enterSequence();
 }
 
+/**
+ * @brief This function will be called after the parser enters a sequence.
+ */
+void KeyListener::enterSequence() { indices.push(0); }
+
 /**
  * @brief This function will be called after the parser exits a sequence.
  *
@@ -119,8 +469,25 @@ void KeyListener::enterSequence(SequenceContext *context
  */
 void KeyListener::exitSequence(SequenceContext *context
                                __attribute__((unused))) {
+  exitSequence();
+}
+
+/**
+ * @brief This function will be called after the parser exits a sequence.
+ */
+void KeyListener::exitSequence() {
+  // The metadata `array` stores the base name of the last element, or an
+  // empty string for an empty array. We only set it once, after we know the
+  // last element.
+  string last;
+  if (indices.top() > 0) {
+    char arrayName[ARRAY_BASE_NAME_SIZE];
+    last = formatArrayBaseName(indices.top() - 1, arrayName).str();
+  }
+  parents.top().setMeta("array", last);
+
   // We add the parent key of all array elements after we leave the sequence
-  keys.append(parents.top());
+  addKey(parents.top());
   indices.pop();
 }
 
@@ -132,19 +499,21 @@ void KeyListener::exitSequence(SequenceContext *context
  */
 void KeyListener::enterElement(ElementContext *context
                                __attribute__((unused))) {
+  enterElement();
+}
 
-  CppKey key{parents.top().getName(), KEY_END};
-  key.addBaseName(indexToArrayBaseName(indices.top()));
+/**
+ * @brief This function will be called after the parser recognizes an element
+ *        of a sequence.
+ */
+void KeyListener::enterElement() {
+  // Array base names do not contain characters Elektra escapes
+  char arrayName[ARRAY_BASE_NAME_SIZE];
+  pushKey(formatArrayBaseName(indices.top(), arrayName));
 
-  uintmax_t index = indices.top();
-  indices.pop();
-  if (index < UINTMAX_MAX) {
-    index++;
+  if (indices.top() < UINTMAX_MAX) {
+    indices.top()++;
   }
-  indices.push(index);
-
-  parents.top().setMeta("array", key.getBaseName());
-  parents.push(key);
 }
 
 /**
@@ -154,5 +523,13 @@ void KeyListener::enterElement(ElementContext *context
  * @param context The context specifies data matched by the rule.
  */
 void KeyListener::exitElement(ElementContext *context __attribute__((unused))) {
-  parents.pop(); // Remove the key for the current array entry
+  exitElement();
+}
+
+/**
+ * @brief This function will be called after the parser read an element of a
+ *        sequence.
+ */
+void KeyListener::exitElement() {
+  popKey(); // Remove the key for the current array entry
 }
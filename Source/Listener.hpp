@@ -1,33 +1,106 @@
 // -- Imports ------------------------------------------------------------------
 
+#include <functional>
 #include <stack>
+#include <vector>
 
 #include <kdb.hpp>
 
 #include "YAMLBaseListener.h"
 
+#include "EventListener.hpp"
+
+using std::function;
 using std::stack;
 using std::string;
 using std::to_string;
+using std::vector;
+
+using antlr4::Token;
 
 using antlr::YAMLBaseListener;
 using ValueContext = antlr::YAML::ValueContext;
 using PairContext = antlr::YAML::PairContext;
+using KeyContext = antlr::YAML::KeyContext;
+using ChildContext = antlr::YAML::ChildContext;
+using BareDocumentContext = antlr::YAML::BareDocumentContext;
+using ExplicitDocumentContext = antlr::YAML::ExplicitDocumentContext;
 using SequenceContext = antlr::YAML::SequenceContext;
 using ElementContext = antlr::YAML::ElementContext;
 
 using CppKey = kdb::Key;
 using CppKeySet = kdb::KeySet;
 
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function returns the Elektra array base name for an index.
+ *
+ * @param index This number specifies the index of the array entry.
+ *
+ * @return The base name of the array entry with index `index` (e.g. `#0` or
+ *         `#_10`)
+ */
+string arrayBaseName(uintmax_t const index);
+
 // -- Class --------------------------------------------------------------------
 
 /**
  * @brief This class creates a key set by listening to matches of grammar rules
  *        specified via YAML.g4.
+ *
+ * The listener works with the ANTLR parser and with the event parser (via the
+ * methods of `EventListener`). The methods for the ANTLR parser extract the
+ * required data from the rule context and then call the corresponding event
+ * method.
+ *
+ * The methods for the ANTLR parser only access the start token of a context,
+ * never its children. This way the listener works with a parse tree walker,
+ * as well as a parse listener of a parser that does not build a parse tree.
+ *
+ * If the listener knows the text the lexer scans, then it reads scalars
+ * directly from this text using the start and stop index of the token.
+ * Afterwards the listener decodes the scalar into a reused buffer, which adds
+ * the null character the C API of Elektra requires. This way the listener
+ * does not allocate memory for scalars, apart from the memory of the key.
+ *
+ * The keys of a stream with a single document are located directly below the
+ * parent key. If the stream contains multiple documents, then the listener
+ * stores them like the elements of a sequence: The keys of the first document
+ * are located below `parent/#0`, the keys of the second document below
+ * `parent/#1`, and so on. An empty document still adds its key (e.g.
+ * `parent/#2`) with an empty value, so the array does not contain holes.
+ *
+ * Instead of storing all keys until the end of the input, the listener can
+ * also pass the keys to a consumer in batches (see `setConsumer`). In this
+ * case the memory usage of the listener only depends on the size of a batch.
+ * A key might then appear in more than one batch, if the listener changes
+ * the key after it passed it on. The listener is only able to nest the keys
+ * of the first document, if it did not pass any of them on yet. A user that
+ * needs to handle streams with multiple large documents therefore calls
+ * `nestAllDocuments`: The listener then stores every document below its
+ * array base name, even if the stream contains only a single document.
  */
-class KeyListener : public YAMLBaseListener {
-  /** This variable stores a key set representing the textual input. */
-  CppKeySet keys;
+class KeyListener : public YAMLBaseListener, public EventListener {
+  /**
+   * This vector stores the keys representing the textual input, in the order
+   * the listener created them.
+   *
+   * Adding keys to a key set one by one is expensive, if they do not arrive
+   * in order: Each insertion moves all keys behind the new key. The listener
+   * therefore sorts the keys only once and then creates the key set in a
+   * single step.
+   */
+  vector<CppKey> keys;
+
+  /** This function receives the keys in batches, if it is not empty. */
+  function<void(CppKeySet &)> consumer;
+
+  /** This number specifies the number of keys in a batch. */
+  size_t batchSize = 0;
+
+  /** This number stores the number of batches the listener passed on. */
+  uintmax_t batches = 0;
 
   /**
    * This stack stores a key for each level of the current key name below
@@ -35,11 +108,142 @@ class KeyListener : public YAMLBaseListener {
    */
   stack<CppKey> parents;
 
+  /**
+   * This key stores a copy of the parent key, as the listener received it.
+   * The parent of a stream with multiple documents does not contain the value
+   * of the first document.
+   */
+  CppKey original;
+
+  /** This variable stores the number of documents the parser entered. */
+  uintmax_t documents = 0;
+
+  /**
+   * This boolean specifies if the listener did not add any key since the
+   * parser entered the current document.
+   */
+  bool emptyDocument = false;
+
+  /**
+   * This boolean specifies if the listener stores the first document below
+   * `#0`, before it knows that the stream contains multiple documents.
+   */
+  bool alwaysNest = false;
+
   /**
    * This stack stores indices for the next array elements.
    */
   stack<uintmax_t> indices;
 
+  /**
+   * This string stores the escaped name of the key on top of `parents`. The
+   * listener adds and removes base names at the end of this string, instead
+   * of copying the name of the parent for every new key.
+   */
+  string name;
+
+  /**
+   * This stack stores the length of `name` before the listener added the
+   * base name of each key in `parents` (except the first one).
+   */
+  stack<size_t> lengths;
+
+  /**
+   * This key stores the last base name the listener escaped. The listener
+   * uses the key to escape base names with the rules of Elektra.
+   */
+  CppKey escaper;
+
+  /**
+   * This pointer stores the UTF-8 text the lexer scans, or `nullptr` if the
+   * token indices do not refer to bytes of a buffer.
+   */
+  char const *input;
+
+  /**
+   * This variable stores the text of the last key the parser read, as long as
+   * the listener does not know if a value follows the key.
+   */
+  ScalarView pendingKey;
+
+  /** This string stores the text of `pendingKey`, if `input` is empty. */
+  string pendingKeyText;
+
+  /** This boolean specifies if `pendingKey` stores a key. */
+  bool keyPending = false;
+
+  /**
+   * This string stores the decoded content of the last scalar for the C API
+   * of Elektra. The listener reuses the memory of the string for every
+   * scalar.
+   */
+  string buffer;
+
+  /**
+   * @brief This method returns the text of a scalar token.
+   *
+   * @param token This parameter stores the scalar token.
+   * @param storage This string stores a copy of the text, if the listener
+   *                does not know the input of the lexer.
+   *
+   * @return A view of the text of `token` (including quote characters)
+   */
+  ScalarView scalar(Token *token, string &storage) const;
+
+  /**
+   * @brief This method decodes the content of a scalar into `buffer`.
+   *
+   * @param text This parameter stores the text of the scalar (including
+   *             quote characters).
+   *
+   * @return The null terminated content of the scalar
+   */
+  char const *decode(ScalarView const &text);
+
+  /**
+   * @brief This method escapes a base name.
+   *
+   * @param baseName This parameter stores the unescaped base name.
+   *
+   * @return A view of the escaped base name, which stays valid until the
+   *         next call of this method
+   */
+  ScalarView escape(char const *baseName);
+
+  /**
+   * @brief This method adds a key to the result.
+   *
+   * If the listener has a consumer, then the method passes the collected
+   * keys on, as soon as they fill a batch.
+   *
+   * @param key This parameter stores the key this method adds.
+   */
+  void addKey(CppKey const &key);
+
+  /**
+   * @brief This method adds a key below the key on top of `parents`.
+   *
+   * @param baseName This parameter stores the escaped base name of the new
+   *                 key.
+   *
+   * @return The new key
+   */
+  CppKey pushKey(ScalarView const &baseName);
+
+  /**
+   * @brief This method removes the key on top of `parents`.
+   */
+  void popKey();
+
+  /**
+   * @brief This method moves the keys of the first document below the array
+   *        base name `#0`.
+   *
+   * @throws std::runtime_error If the listener already passed keys of the
+   *                            first document to its consumer
+   */
+  void nestFirstDocument();
+
 public:
   /**
    * @brief This constructor creates a new empty key storage using the given
@@ -47,16 +251,93 @@ public:
    *
    * @param parent This key specifies the parent of all keys stored in the
    *               object.
+   * @param utf8 This pointer stores the start of the UTF-8 encoded text the
+   *             lexer scans. If the token indices do not specify byte offsets
+   *             of this text, then this value has to be `nullptr`.
    */
-  KeyListener(CppKey parent);
+  KeyListener(CppKey parent, char const *utf8 = nullptr);
 
   /**
    * @brief This function returns the data read by the parser.
    *
+   * If the listener has a consumer, then the result only contains the keys
+   * the listener did not pass on yet.
+   *
    * @return The key set representing the data from the textual input
    */
   CppKeySet keySet();
 
+  /**
+   * @brief This method makes the listener pass its keys to a consumer in
+   *        batches.
+   *
+   * @param receiver This function receives each batch of keys as a sorted
+   *                 key set.
+   * @param size This number specifies the number of keys in a batch.
+   */
+  void setConsumer(function<void(CppKeySet &)> receiver, size_t const size);
+
+  /**
+   * @brief This method passes all keys the listener did not pass on yet to
+   *        the consumer.
+   *
+   * Call this method after the parser finished, to receive the last batch.
+   */
+  void flush();
+
+  /**
+   * @brief This method tells the listener to store the keys of every
+   *        document below the array base name of the document.
+   *
+   * Usually the listener stores the keys of a stream with a single document
+   * directly below the parent. After this call it stores them below
+   * `parent/#0` instead. This way the listener never has to move the keys of
+   * the first document, which might have reached the consumer already.
+   */
+  void nestAllDocuments();
+
+  /**
+   * @brief This function will be called after the parser enters a document
+   *        without start marker.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterBareDocument(BareDocumentContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a document
+   *        without start marker.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitBareDocument(BareDocumentContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a document
+   *        with start marker.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterExplicitDocument(ExplicitDocumentContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a document
+   *        with start marker.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitExplicitDocument(ExplicitDocumentContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a document.
+   */
+  void enterDocument() override;
+
+  /**
+   * @brief This function will be called after the parser exits a document.
+   */
+  void exitDocument() override;
+
   /**
    * @brief This function will be called after the parser exits a value.
    *
@@ -64,13 +345,27 @@ public:
    */
   void exitValue(ValueContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser exits a value.
+   *
+   * @param text This parameter stores the text of the scalar (including
+   *             quote characters).
+   */
+  void exitValue(ScalarView const &text) override;
+
+  // The listener reads the key of a pair in `exitKey`
+  using YAMLBaseListener::enterPair;
+
   /**
    * @brief This function will be called after the parser enters a key-value
    *        pair.
    *
-   * @param context The context specifies data matched by the rule.
+   * @param key This parameter stores the text of the scalar that specifies
+   *            the key (including quote characters).
+   * @param hasValue This boolean specifies if the pair contains a value
+   *                 (child) after the key.
    */
-  virtual void enterPair(PairContext *context) override;
+  virtual void enterPair(ScalarView const &key, bool const hasValue) override;
 
   /**
    * @brief This function will be called after the parser exits a key-value
@@ -80,6 +375,28 @@ public:
    */
   virtual void exitPair(PairContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser exits the key of a
+   *        key-value pair.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void exitKey(KeyContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a child
+   *        (value, map or sequence).
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void enterChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a key-value
+   *        pair.
+   */
+  virtual void exitPair() override;
+
   /**
    * @brief This function will be called after the parser enters a sequence.
    *
@@ -87,6 +404,11 @@ public:
    */
   virtual void enterSequence(SequenceContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser enters a sequence.
+   */
+  virtual void enterSequence() override;
+
   /**
    * @brief This function will be called after the parser exits a sequence.
    *
@@ -94,6 +416,11 @@ public:
    */
   virtual void exitSequence(SequenceContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser exits a sequence.
+   */
+  virtual void exitSequence() override;
+
   /**
    * @brief This function will be called after the parser recognizes an element
    *        of a sequence.
@@ -102,6 +429,12 @@ public:
    */
   virtual void enterElement(ElementContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser recognizes an element
+   *        of a sequence.
+   */
+  virtual void enterElement() override;
+
   /**
    * @brief This function will be called after the parser read an element of a
    *        sequence.
@@ -109,4 +442,10 @@ public:
    * @param context The context specifies data matched by the rule.
    */
   virtual void exitElement(ElementContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser read an element of a
+   *        sequence.
+   */
+  virtual void exitElement() override;
 };
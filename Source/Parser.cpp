@@ -0,0 +1,311 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <sstream>
+
+#include "EventParser.hpp"
+#include "Listener.hpp"
+#include "Parser.hpp"
+#include "TwoStageParser.hpp"
+
+using std::endl;
+using std::ostringstream;
+
+using ParseTreeWalker = antlr4::tree::ParseTreeWalker;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function returns the UTF-8 text of a generic character stream.
+ *
+ * A generic character stream does not provide access to its data, and its
+ * indices count code points instead of bytes.
+ *
+ * @param input This parameter specifies a character stream.
+ *
+ * @return `nullptr`
+ */
+char const *bufferText(CharStream *input __attribute__((unused))) {
+  return nullptr;
+}
+
+/**
+ * @brief This function returns the UTF-8 text of a buffer stream.
+ *
+ * @param input This parameter specifies a buffer stream.
+ *
+ * @return The UTF-8 data of `input`
+ */
+char const *bufferText(BufferStream *input) { return input->data(); }
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parser session.
+ *
+ * @param how This parameter specifies how the parser turns tokens into keys.
+ * @param mode This parameter specifies the prediction mode of the ANTLR
+ *             parser.
+ * @param output This parameter stores the logger that receives the trace
+ *               messages of the lexer. If this parameter is `nullptr`, then
+ *               the lexer does not print any messages.
+ * @param stages This parameter specifies if the lexer runs on a thread of its
+ *               own.
+ */
+template <typename Input>
+Parser<Input>::Parser(Strategy const how, Prediction const mode,
+                      shared_ptr<logger> output, Pipeline const stages)
+    : strategy{how}, prediction{mode}, pipeline{stages}, console{output} {}
+
+/**
+ * @brief This method converts YAML data to a key set.
+ *
+ * @param input This parameter stores the YAML data the method parses.
+ * @param parent This key specifies the parent of all keys in the result. The
+ *               method does not modify this key.
+ * @param line This number specifies the line number of the first line of
+ *             `input`.
+ *
+ * @return A key set representing the data in `input`
+ */
+template <typename Input>
+CppKeySet Parser<Input>::parse(Input *input, CppKey const &parent,
+                               size_t const line) {
+  firstLine = line;
+  prepare(input);
+  char const *utf8 = bufferText(input);
+  return strategy == Strategy::EVENT ? parseEvents(parent, utf8)
+                                     : parseANTLR(parent, utf8);
+}
+
+/**
+ * @brief This method sets the stream the session writes error messages to.
+ *
+ * @param stream This parameter stores the stream that receives the error
+ *               messages of all following calls of `parse`.
+ */
+template <typename Input> void Parser<Input>::setErrorStream(ostream &stream) {
+  errorStream = &stream;
+  if (errorListener) {
+    errorListener->setOutput(stream);
+  }
+}
+
+/**
+ * @brief This method returns the number of syntax errors in the last input.
+ *
+ * @return The number of errors the lexer and parser reported
+ */
+template <typename Input>
+size_t Parser<Input>::getNumberOfSyntaxErrors() const {
+  return errors;
+}
+
+/**
+ * @brief This method returns the tokens of the last input.
+ *
+ * @return The token stream of the session or `nullptr`, if the session did
+ *         not parse any input yet
+ */
+template <typename Input>
+CommonTokenStream *Parser<Input>::getTokenStream() const {
+  return tokens.get();
+}
+
+/**
+ * @brief This method returns the parse tree of the last input.
+ *
+ * @return The parse tree of the last input, or `nullptr` if the parser did
+ *         not build a parse tree
+ */
+template <typename Input> ParseTree *Parser<Input>::getParseTree() const {
+  return tree;
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method prepares all objects of the session for a new input.
+ *
+ * @param input This parameter stores the input the session parses next.
+ */
+template <typename Input> void Parser<Input>::prepare(Input *input) {
+  tree = nullptr;
+  errors = 0;
+
+  if (!lexer) {
+    lexer.reset(new YAMLLexer<Input>{input, console});
+    source = lexer.get();
+    if (pipeline == Pipeline::LEXER) {
+      lexerThread.reset(new TokenPipeline<Input>{});
+      source = lexerThread.get();
+    }
+    tokens.reset(new CommonTokenStream{source});
+    parser.reset(new YAML{tokens.get()});
+    errorListener.reset(
+        new ErrorListener{&lexer->getLineIndex(), *errorStream});
+  } else {
+    // The token stream owns the tokens of the last input. We have to destroy
+    // them, before the lexer releases their memory.
+    if (lexerThread) {
+      lexerThread->stop();
+    }
+    tokens->setTokenSource(source);
+    lexer->reset(input);
+    parser->setTokenStream(tokens.get()); // This call also resets the parser
+  }
+  errorListener->setFirstLine(firstLine);
+
+  if (lexerThread) {
+    // The producer thread extends the line index, while the parser runs. The
+    // tokens store their positions explicitly instead.
+    errorListener->setLineIndex(nullptr);
+    lexerThread->start(lexer.get());
+  }
+}
+
+/**
+ * @brief This method reports an error of the lexer.
+ *
+ * @param error This parameter stores the exception of the lexer.
+ */
+template <typename Input>
+void Parser<Input>::reportLexerError(ParseCancellationException const &error) {
+  size_t const index = lexer->getInputStream()->index();
+  LineIndex const &positions = lexer->getLineIndex();
+  *errorStream << positions.line(index) + firstLine - 1 << ":"
+               << positions.column(index) << " " << error.what() << endl;
+  errors = 1;
+}
+
+/**
+ * @brief This method parses the input of the lexer with the ANTLR parser.
+ *
+ * @param parent This key specifies the parent of all keys in the result.
+ * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr` if
+ *             the token indices do not specify byte offsets.
+ *
+ * @return A key set representing the input
+ */
+template <typename Input>
+CppKeySet Parser<Input>::parseANTLR(CppKey const &parent, char const *utf8) {
+  if (!lexerThread) {
+    try {
+      tokens->fill();
+    } catch (ParseCancellationException const &error) {
+      // The lexer cancels the parsing process, if it is unable to tokenize
+      // the input
+      reportLexerError(error);
+      return CppKeySet{};
+    }
+    return parseTokens(parent, utf8);
+  }
+
+  // With a pipeline the lexer may fail after the parser reported errors in
+  // front of the failure. We only print these errors, if the lexer succeeds.
+  ostringstream messages;
+  errorListener->setOutput(messages);
+  try {
+    CppKeySet keys = parseTokens(parent, utf8);
+    tokens->fill(); // The parser might stop in front of a lexer error
+    errorListener->setOutput(*errorStream);
+    *errorStream << messages.str();
+    return keys;
+  } catch (ParseCancellationException const &error) {
+    errorListener->setOutput(*errorStream);
+    lexerThread->stop();
+    parser->removeParseListeners();
+    tree = nullptr;
+    reportLexerError(error);
+    return CppKeySet{};
+  }
+}
+
+/**
+ * @brief This method parses the tokens of the token stream with the ANTLR
+ *        parser.
+ *
+ * @param parent This key specifies the parent of all keys in the result.
+ * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr` if
+ *             the token indices do not specify byte offsets.
+ *
+ * @return A key set representing the input
+ */
+template <typename Input>
+CppKeySet Parser<Input>::parseTokens(CppKey const &parent, char const *utf8) {
+  KeyListener listener{parent.dup(), utf8};
+  bool const streaming = strategy == Strategy::STREAM;
+  // Without a parse tree, the parser calls the listener while it parses the
+  // input
+  parser->setBuildParseTree(!streaming);
+  parser->removeParseListeners();
+  if (streaming) {
+    parser->addParseListener(&listener);
+  }
+
+  if (prediction == Prediction::TWO_STAGE) {
+    tree = parseTwoStage(*parser, *tokens, *errorListener,
+                         [&listener, &parent, utf8]() {
+                           // Discard the keys of the failed first stage
+                           listener = KeyListener{parent.dup(), utf8};
+                         },
+                         !lexerThread);
+  } else {
+    parser->removeErrorListeners();
+    parser->addErrorListener(errorListener.get());
+    tree = parser->yaml();
+  }
+  errors = parser->getNumberOfSyntaxErrors();
+
+  if (streaming) {
+    parser->removeParseListeners();
+    tree = nullptr;
+  } else {
+    ParseTreeWalker walker{};
+    walker.walk(&listener, tree);
+  }
+  return listener.keySet();
+}
+
+/**
+ * @brief This method parses the input of the lexer with the event parser.
+ *
+ * @param parent This key specifies the parent of all keys in the result.
+ * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr` if
+ *             the token indices do not specify byte offsets.
+ *
+ * @return A key set representing the input
+ */
+template <typename Input>
+CppKeySet Parser<Input>::parseEvents(CppKey const &parent, char const *utf8) {
+  // The event parser reads the tokens directly from the lexer. It neither
+  // buffers the token stream, nor builds a parse tree.
+  KeyListener listener{parent.dup(), utf8};
+  EventParser events{source, utf8};
+  events.setErrorListener(errorListener.get());
+  try {
+    errors = events.parse(listener);
+  } catch (ParseCancellationException const &error) {
+    // Like the ANTLR parser, we do not return the keys in front of a lexer
+    // error. The pipeline already stopped its thread, before it passed on the
+    // exception of the lexer.
+    reportLexerError(error);
+    return CppKeySet{};
+  }
+  if (lexerThread) {
+    // The event parser stops at the first error, even if the lexer is still
+    // scanning the input
+    lexerThread->stop();
+  }
+  return listener.keySet();
+}
+
+// -- Instantiations -----------------------------------------------------------
+
+template class Parser<CharStream>;
+template class Parser<BufferStream>;
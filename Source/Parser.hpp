@@ -0,0 +1,253 @@
+#ifndef PARSER_HPP
+#define PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <memory>
+
+#include <antlr4-runtime.h>
+#include <kdb.hpp>
+
+#include "YAML.h"
+
+#include "BufferStream.hpp"
+#include "ErrorListener.hpp"
+#include "TokenPipeline.hpp"
+#include "YAMLLexer.hpp"
+
+using std::ostream;
+using std::shared_ptr;
+using std::unique_ptr;
+
+using antlr4::CharStream;
+using antlr4::CommonTokenStream;
+using antlr4::ParseCancellationException;
+using ParseTree = antlr4::tree::ParseTree;
+
+using antlr::YAML;
+
+using spdlog::logger;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration lists the ways a `Parser` turns tokens into keys. */
+enum class Strategy {
+  /** The ANTLR parser builds a parse tree, which a walker visits afterwards. */
+  TREE,
+  /** The ANTLR parser calls the listener, without building a parse tree. */
+  STREAM,
+  /** The recursive descent parser `EventParser` calls the listener. */
+  EVENT
+};
+
+/** This enumeration lists the prediction modes of the ANTLR parser. */
+enum class Prediction {
+  /** The parser uses SLL prediction and only falls back to LL on failure. */
+  TWO_STAGE,
+  /** The parser always uses full LL prediction. */
+  LL
+};
+
+/** This enumeration lists the ways a `Parser` distributes its work. */
+enum class Pipeline {
+  /** The lexer produces each token, when the parser requests it. */
+  NONE,
+  /**
+   * The lexer runs on a thread of its own and produces tokens in front of
+   * the parser (see `TokenPipeline`).
+   */
+  LEXER
+};
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts YAML data to a key set and keeps its state
+ *        between multiple inputs.
+ *
+ * A parser session creates the lexer, the token stream and the ANTLR parser
+ * only once. For each further input it resets these objects, instead of
+ * creating new ones. This way the ANTLR parser keeps its prediction state
+ * (ATN simulator and DFA cache) warm, and the lexer reuses the memory of its
+ * token arena.
+ *
+ * A session does not use any global state. Different threads can therefore
+ * use different sessions at the same time.
+ *
+ * The parser reports syntax errors on the standard error output, unless
+ * `setErrorStream` specifies another stream. The parse
+ * tree and the tokens of an input stay valid until the next call of `parse`,
+ * as long as the input exists.
+ *
+ * With a pipeline, the session scans and parses an input on two threads at
+ * the same time. The result, the tokens and the error messages stay the same
+ * as without a pipeline: If the lexer fails, then the session only reports
+ * the lexer error, even if the parser already found errors in front of it.
+ */
+template <typename Input = BufferStream> class Parser {
+  /** This variable specifies how the parser turns tokens into keys. */
+  Strategy strategy;
+
+  /** This variable specifies the prediction mode of the ANTLR parser. */
+  Prediction prediction;
+
+  /** This variable specifies if the lexer runs on a thread of its own. */
+  Pipeline pipeline;
+
+  /** This variable stores the logger for the trace messages of the lexer. */
+  shared_ptr<logger> console;
+
+  /** This variable stores the lexer of the session. */
+  unique_ptr<YAMLLexer<Input>> lexer;
+
+  /** This variable stores the thread of the lexer or `nullptr`. */
+  unique_ptr<TokenPipeline<Input>> lexerThread;
+
+  /** This variable stores the source of the tokens the parser reads. */
+  TokenSource *source = nullptr;
+
+  /** This variable stores the tokens the lexer produced. */
+  unique_ptr<CommonTokenStream> tokens;
+
+  /** This variable stores the ANTLR parser of the session. */
+  unique_ptr<YAML> parser;
+
+  /** This variable stores the listener that reports syntax errors. */
+  unique_ptr<ErrorListener> errorListener;
+
+  /** This variable stores the stream the session writes error messages to. */
+  ostream *errorStream = &std::cerr;
+
+  /** This variable stores the parse tree of the last input or `nullptr`. */
+  ParseTree *tree = nullptr;
+
+  /** This variable stores the number of syntax errors in the last input. */
+  size_t errors = 0;
+
+  /** This variable stores the line number of the first line of the input. */
+  size_t firstLine = 1;
+
+  /**
+   * @brief This method prepares all objects of the session for a new input.
+   *
+   * @param input This parameter stores the input the session parses next.
+   */
+  void prepare(Input *input);
+
+  /**
+   * @brief This method reports an error of the lexer.
+   *
+   * @param error This parameter stores the exception of the lexer.
+   */
+  void reportLexerError(ParseCancellationException const &error);
+
+  /**
+   * @brief This method parses the input of the lexer with the ANTLR parser.
+   *
+   * @param parent This key specifies the parent of all keys in the result.
+   * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr`
+   *             if the token indices do not specify byte offsets.
+   *
+   * @return A key set representing the input
+   */
+  CppKeySet parseANTLR(CppKey const &parent, char const *utf8);
+
+  /**
+   * @brief This method parses the tokens of the token stream with the ANTLR
+   *        parser.
+   *
+   * @param parent This key specifies the parent of all keys in the result.
+   * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr`
+   *             if the token indices do not specify byte offsets.
+   *
+   * @return A key set representing the input
+   */
+  CppKeySet parseTokens(CppKey const &parent, char const *utf8);
+
+  /**
+   * @brief This method parses the input of the lexer with the event parser.
+   *
+   * @param parent This key specifies the parent of all keys in the result.
+   * @param utf8 This pointer stores the UTF-8 text of the input, or `nullptr`
+   *             if the token indices do not specify byte offsets.
+   *
+   * @return A key set representing the input
+   */
+  CppKeySet parseEvents(CppKey const &parent, char const *utf8);
+
+public:
+  /**
+   * @brief This constructor creates a new parser session.
+   *
+   * @param how This parameter specifies how the parser turns tokens into
+   *            keys.
+   * @param mode This parameter specifies the prediction mode of the ANTLR
+   *             parser.
+   * @param output This parameter stores the logger that receives the trace
+   *               messages of the lexer. If this parameter is `nullptr`, then
+   *               the lexer does not print any messages.
+   * @param stages This parameter specifies if the lexer runs on a thread of
+   *               its own.
+   */
+  Parser(Strategy const how = Strategy::TREE,
+         Prediction const mode = Prediction::TWO_STAGE,
+         shared_ptr<logger> output = nullptr,
+         Pipeline const stages = Pipeline::NONE);
+
+  /**
+   * @brief This method converts YAML data to a key set.
+   *
+   * @param input This parameter stores the YAML data the method parses.
+   * @param parent This key specifies the parent of all keys in the result.
+   *               The method does not modify this key.
+   * @param line This number specifies the line number of the first line of
+   *             `input`. Error messages report lines relative to this
+   *             number, which is useful if `input` is only a part of a file.
+   *
+   * @return A key set representing the data in `input`
+   */
+  CppKeySet parse(Input *input, CppKey const &parent, size_t const line = 1);
+
+  /**
+   * @brief This method sets the stream the session writes error messages to.
+   *
+   * @param stream This parameter stores the stream that receives the error
+   *               messages of all following calls of `parse`.
+   */
+  void setErrorStream(ostream &stream);
+
+  /**
+   * @brief This method returns the number of syntax errors in the last input.
+   *
+   * @return The number of errors the lexer and parser reported
+   */
+  size_t getNumberOfSyntaxErrors() const;
+
+  /**
+   * @brief This method returns the tokens of the last input.
+   *
+   * The event parser reads tokens directly from the lexer. For this strategy
+   * the token stream is therefore empty.
+   *
+   * @return The token stream of the session or `nullptr`, if the session did
+   *         not parse any input yet
+   */
+  CommonTokenStream *getTokenStream() const;
+
+  /**
+   * @brief This method returns the parse tree of the last input.
+   *
+   * @return The parse tree of the last input, or `nullptr` if the parser did
+   *         not build a parse tree
+   */
+  ParseTree *getParseTree() const;
+};
+
+extern template class Parser<CharStream>;
+extern template class Parser<BufferStream>;
+
+#endif // PARSER_HPP
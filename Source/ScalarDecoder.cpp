@@ -0,0 +1,311 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "ScalarDecoder.hpp"
+#include "ScanKernels.hpp"
+
+using std::uint32_t;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/** A single quoted scalar needs decoding, if it contains these characters. */
+StopBytes const SINGLE_QUOTED_ESCAPES{'\'', '\n', '\'', '\n'};
+
+/** A double quoted scalar needs decoding, if it contains these characters. */
+StopBytes const DOUBLE_QUOTED_ESCAPES{'\\', '\n', '\\', '\n'};
+
+/** This code point replaces invalid UTF-16 surrogates. */
+uint32_t const REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * @brief This function checks if a character is a space or a tab.
+ *
+ * @param character This parameter stores the character this function checks.
+ *
+ * @retval true If `character` is a space or a tab
+ *         false Otherwise
+ */
+inline bool isBlank(char const character) {
+  return character == ' ' || character == '\t';
+}
+
+/**
+ * @brief This function appends the UTF-8 encoding of a code point to a
+ *        string.
+ *
+ * @param codePoint This number specifies the code point this function
+ *                  encodes.
+ * @param text This parameter stores the string this function appends to.
+ */
+void appendUTF8(uint32_t const codePoint, string &text) {
+  if (codePoint < 0x80) {
+    text += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    text += static_cast<char>(0xC0 | codePoint >> 6);
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    text += static_cast<char>(0xE0 | codePoint >> 12);
+    text += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    text += static_cast<char>(0xF0 | codePoint >> 18);
+    text += static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+    text += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+/**
+ * @brief This function reads a hexadecimal number with a fixed number of
+ *        digits.
+ *
+ * @param data This pointer stores the start of the digits.
+ * @param digits This number specifies the number of hexadecimal digits.
+ * @param value This parameter stores the value of the number, if the function
+ *              succeeds.
+ *
+ * @retval true If `data` starts with `digits` hexadecimal digits
+ *         false Otherwise
+ */
+bool readHex(char const *data, size_t const digits, uint32_t &value) {
+  value = 0;
+  for (size_t offset = 0; offset < digits; offset++) {
+    char const digit = data[offset];
+    uint32_t nibble;
+    if (digit >= '0' && digit <= '9') {
+      nibble = digit - '0';
+    } else if (digit >= 'a' && digit <= 'f') {
+      nibble = digit - 'a' + 10;
+    } else if (digit >= 'A' && digit <= 'F') {
+      nibble = digit - 'A' + 10;
+    } else {
+      return false;
+    }
+    value = value << 4 | nibble;
+  }
+  return true;
+}
+
+/**
+ * @brief This function folds the line breaks at the given position.
+ *
+ * @param content This parameter stores the content of a quoted scalar.
+ * @param position This number specifies the offset of a newline character in
+ *                 `content`.
+ * @param escaped This boolean specifies if a backslash escapes the first line
+ *                break. In this case the function does not add a space for
+ *                this line break.
+ * @param text This parameter stores the string this function appends the
+ *             folded line breaks to.
+ *
+ * @return The offset of the first character in `content` after the line
+ *         breaks and the indentation of the next line
+ */
+size_t foldLines(ScalarView const &content, size_t position,
+                 bool const escaped, string &text) {
+  char const *data = content.data();
+  size_t const size = content.size();
+
+  size_t breaks = 0;
+  while (position < size && data[position] == '\n') {
+    breaks++;
+    position++;
+    while (position < size && isBlank(data[position])) {
+      position++;
+    }
+  }
+
+  // Each empty line adds a newline, a single line break adds a space
+  text.append(breaks - 1, '\n');
+  if (breaks == 1 && !escaped) {
+    text += ' ';
+  }
+  return position;
+}
+
+/**
+ * @brief This function decodes an escape sequence of a double quoted scalar.
+ *
+ * @param content This parameter stores the content of a double quoted
+ *                scalar.
+ * @param position This number specifies the offset of the character after a
+ *                 backslash in `content`.
+ * @param text This parameter stores the string this function appends the
+ *             decoded character to.
+ *
+ * @return The offset of the first character in `content` after the escape
+ *         sequence
+ */
+size_t decodeEscape(ScalarView const &content, size_t const position,
+                    string &text) {
+  char const *data = content.data();
+  size_t const size = content.size();
+
+  if (position >= size) {
+    text += '\\';
+    return position;
+  }
+
+  size_t digits = 0;
+  switch (data[position]) {
+  case '0':
+    text += '\0';
+    return position + 1;
+  case 'a':
+    text += '\a';
+    return position + 1;
+  case 'b':
+    text += '\b';
+    return position + 1;
+  case 't':
+  case '\t':
+    text += '\t';
+    return position + 1;
+  case 'n':
+    text += '\n';
+    return position + 1;
+  case 'v':
+    text += '\v';
+    return position + 1;
+  case 'f':
+    text += '\f';
+    return position + 1;
+  case 'r':
+    text += '\r';
+    return position + 1;
+  case 'e':
+    text += '\x1B';
+    return position + 1;
+  case ' ':
+  case '"':
+  case '/':
+  case '\\':
+    text += data[position];
+    return position + 1;
+  case 'N':
+    appendUTF8(0x85, text);
+    return position + 1;
+  case '_':
+    appendUTF8(0xA0, text);
+    return position + 1;
+  case 'L':
+    appendUTF8(0x2028, text);
+    return position + 1;
+  case 'P':
+    appendUTF8(0x2029, text);
+    return position + 1;
+  case '\n':
+    // An escaped line break continues the scalar without adding a space
+    return foldLines(content, position, true, text);
+  case 'x':
+    digits = 2;
+    break;
+  case 'u':
+    digits = 4;
+    break;
+  case 'U':
+    digits = 8;
+    break;
+  }
+
+  uint32_t codePoint;
+  if (digits == 0 || size - position - 1 < digits ||
+      !readHex(data + position + 1, digits, codePoint) ||
+      codePoint > 0x10FFFF) {
+    text += '\\'; // Keep the invalid escape sequence
+    return position;
+  }
+  size_t next = position + 1 + digits;
+
+  if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+    // Combine UTF-16 surrogate pairs such as `\uD83D\uDE00`
+    uint32_t low;
+    if (codePoint <= 0xDBFF && size - next >= 6 && data[next] == '\\' &&
+        data[next + 1] == 'u' && readHex(data + next + 2, 4, low) &&
+        low >= 0xDC00 && low <= 0xDFFF) {
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+      next += 6;
+    } else {
+      codePoint = REPLACEMENT_CHARACTER;
+    }
+  }
+  appendUTF8(codePoint, text);
+  return next;
+}
+
+/**
+ * @brief This function decodes the content of a quoted scalar, starting at
+ *        the first character that needs decoding.
+ *
+ * @param content This parameter stores the content of a quoted scalar
+ *                (without quote characters).
+ * @param position This number specifies the offset of the first character
+ *                 in `content` that needs decoding. `text` already stores
+ *                 all characters before this offset.
+ * @param doubleQuoted This boolean specifies if `content` belongs to a
+ *                     double quoted scalar.
+ * @param text This parameter stores the string this function appends the
+ *             decoded content to.
+ */
+void decodeQuoted(ScalarView const &content, size_t position,
+                  bool const doubleQuoted, string &text) {
+  char const *data = content.data();
+  size_t const size = content.size();
+  StopBytes const &escapes =
+      doubleQuoted ? DOUBLE_QUOTED_ESCAPES : SINGLE_QUOTED_ESCAPES;
+
+  // Folding removes trailing whitespace before a line break, but not
+  // whitespace produced by an escape sequence
+  size_t decoded = 0;
+  while (position < size) {
+    if (data[position] == '\n') {
+      while (text.size() > decoded && isBlank(text.back())) {
+        text.pop_back();
+      }
+      position = foldLines(content, position, false, text);
+    } else if (doubleQuoted) {
+      position = decodeEscape(content, position + 1, text);
+    } else {
+      text += '\''; // Fold `''` into `'`
+      position += 2;
+    }
+    decoded = text.size();
+
+    size_t const stop =
+        position + findStop(data + position, size - position, escapes);
+    text.append(data + position, stop - position);
+    position = stop;
+  }
+}
+
+} // namespace
+
+/**
+ * @brief This function converts the text of a scalar token to the content of
+ *        the scalar.
+ *
+ * @param scalar This parameter stores the text of a scalar token (including
+ *               quote characters).
+ * @param text This string stores the content of `scalar`, after the function
+ *             returns. The function reuses the memory of the string.
+ */
+void decodeScalar(ScalarView const &scalar, string &text) {
+  ScalarView const content = scalar.unquote();
+  if (content.data() == scalar.data()) {
+    // Plain scalars do not contain escape sequences
+    text.assign(content.data(), content.size());
+    return;
+  }
+
+  bool const doubleQuoted = *scalar.data() == '"';
+  size_t const stop =
+      findStop(content.data(), content.size(),
+               doubleQuoted ? DOUBLE_QUOTED_ESCAPES : SINGLE_QUOTED_ESCAPES);
+  text.assign(content.data(), stop);
+  if (stop < content.size()) {
+    decodeQuoted(content, stop, doubleQuoted, text);
+  }
+}
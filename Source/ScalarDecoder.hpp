@@ -0,0 +1,39 @@
+#ifndef SCALAR_DECODER_HPP
+#define SCALAR_DECODER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <string>
+
+#include "ScalarView.hpp"
+
+using std::string;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function converts the text of a scalar token to the content of
+ *        the scalar.
+ *
+ * The function removes the quote characters of quoted scalars, replaces `''`
+ * in single quoted scalars with `'` and decodes the escape sequences of
+ * double quoted scalars. It also folds line breaks in quoted scalars: A
+ * single line break becomes a space, while each additional empty line becomes
+ * a newline character.
+ *
+ * Most scalars do not contain escape sequences or line breaks. The function
+ * checks this first, using the vectorized scan kernels, and then copies such
+ * scalars without looking at every single character.
+ *
+ * The function keeps invalid escape sequences, such as `\q`, unchanged.
+ * The lexer rejects escape sequences for the null character (such as `\0`),
+ * since Elektra would cut off the value at this character.
+ *
+ * @param scalar This parameter stores the text of a scalar token (including
+ *               quote characters).
+ * @param text This string stores the content of `scalar`, after the function
+ *             returns. The function reuses the memory of the string.
+ */
+void decodeScalar(ScalarView const &scalar, string &text);
+
+#endif // SCALAR_DECODER_HPP
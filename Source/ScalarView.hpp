@@ -0,0 +1,102 @@
+#ifndef SCALAR_VIEW_HPP
+#define SCALAR_VIEW_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+
+using std::size_t;
+using std::string;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides read-only access to the text of a scalar,
+ *        without owning this text.
+ *
+ * Usually a view points directly into the input buffer of the lexer. The
+ * view is only valid as long as the memory it points to exists.
+ */
+class ScalarView {
+  /** This pointer stores the start of the text. */
+  char const *start = nullptr;
+
+  /** This number specifies the length of the text in bytes. */
+  size_t length = 0;
+
+public:
+  /**
+   * @brief This constructor creates an empty view.
+   */
+  ScalarView() = default;
+
+  /**
+   * @brief This constructor creates a view of the given memory.
+   *
+   * @param text This pointer stores the start of the text.
+   * @param size This number specifies the length of the text in bytes.
+   */
+  ScalarView(char const *text, size_t const size);
+
+  /**
+   * @brief This constructor creates a view of the given string.
+   *
+   * @param text This parameter stores the string the view refers to.
+   */
+  ScalarView(string const &text);
+
+  /**
+   * @brief This method returns the start of the text.
+   *
+   * @return A pointer to the first character of the text
+   */
+  char const *data() const;
+
+  /**
+   * @brief This method returns the length of the text.
+   *
+   * @return The number of bytes in the text
+   */
+  size_t size() const;
+
+  /**
+   * @brief This method removes the leading and trailing quote character of
+   *        a quoted scalar.
+   *
+   * @return A view of the scalar without quote characters
+   */
+  ScalarView unquote() const;
+
+  /**
+   * @brief This method copies the text of the view.
+   *
+   * @return A string containing the text of the view
+   */
+  string str() const;
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline ScalarView::ScalarView(char const *text, size_t const size)
+    : start{text}, length{size} {}
+
+inline ScalarView::ScalarView(string const &text)
+    : start{text.data()}, length{text.size()} {}
+
+inline char const *ScalarView::data() const { return start; }
+
+inline size_t ScalarView::size() const { return length; }
+
+inline ScalarView ScalarView::unquote() const {
+  if (length >= 2 && (*start == '"' || *start == '\'')) {
+    return ScalarView{start + 1, length - 2};
+  }
+  return *this;
+}
+
+inline string ScalarView::str() const {
+  return start == nullptr ? string{} : string{start, length};
+}
+
+#endif // SCALAR_VIEW_HPP
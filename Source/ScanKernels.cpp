@@ -0,0 +1,525 @@
+// -- Imports ------------------------------------------------------------------
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
+#include "ScanKernels.hpp"
+
+using std::memcpy;
+using std::uint64_t;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function searches for the first stop byte in the given data
+ *        one byte at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param stops This parameter specifies the bytes this function searches for.
+ *
+ * @return The offset of the first stop byte in `data` or `size`
+ */
+size_t findStopScalar(char const *data, size_t const size,
+                      StopBytes const &stops) {
+  size_t offset = 0;
+  while (offset < size &&
+         !stops.contains(static_cast<unsigned char>(data[offset]))) {
+    offset++;
+  }
+  return offset;
+}
+
+/**
+ * @brief This function counts the code points in the given UTF-8 data one
+ *        byte at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ *
+ * @return The number of bytes in `data` that start a code point
+ */
+size_t countCodePointsScalar(char const *data, size_t const size) {
+  size_t codePoints = 0;
+  for (size_t offset = 0; offset < size; offset++) {
+    codePoints += (static_cast<unsigned char>(data[offset]) & 0xc0) != 0x80;
+  }
+  return codePoints;
+}
+
+/**
+ * @brief This function checks if the given byte separates a YAML indicator
+ *        from the following text.
+ *
+ * @param character This parameter stores the byte this function checks.
+ *
+ * @retval true If `character` is a space or newline
+ *         false Otherwise
+ */
+inline bool isWhitespace(char const character) {
+  return character == ' ' || character == '\n';
+}
+
+/**
+ * @brief This function determines the positions of structural characters one
+ *        byte at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters.
+ */
+void findStructuralsScalar(char const *data, size_t const size,
+                           vector<uint32_t> &positions) {
+  for (size_t offset = 0; offset < size; offset++) {
+    switch (data[offset]) {
+    case '\n':
+    case '"':
+    case '\'':
+    case '\\':
+      positions.push_back(static_cast<uint32_t>(offset));
+      break;
+    case ':':
+    case '-':
+    case '#':
+      if (offset + 1 < size && isWhitespace(data[offset + 1])) {
+        positions.push_back(static_cast<uint32_t>(offset));
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+/**
+ * This structure stores bitmaps of the interesting characters in a block of
+ * 64 bytes. Bit `n` of each map corresponds to byte `n` of the block.
+ */
+struct BlockMasks {
+  /** This map stores newlines, quotes and backslashes. */
+  uint64_t special;
+  /** This map stores the indicators `:`, `-` and `#`. */
+  uint64_t indicators;
+  /** This map stores spaces and newlines. */
+  uint64_t whitespace;
+};
+
+/**
+ * @brief This function adds the structural characters of a block to a list of
+ *        positions.
+ *
+ * @param masks This parameter stores the bitmaps of the block.
+ * @param nextIsWhitespace This value specifies if the byte after the block is
+ *                         a space or newline.
+ * @param offset This number specifies the offset of the block.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters.
+ */
+inline void addStructurals(BlockMasks const &masks, bool const nextIsWhitespace,
+                           size_t const offset, vector<uint32_t> &positions) {
+  uint64_t const followedByWhitespace =
+      (masks.whitespace >> 1) | (static_cast<uint64_t>(nextIsWhitespace) << 63);
+  uint64_t structurals =
+      masks.special | (masks.indicators & followedByWhitespace);
+  while (structurals != 0) {
+    positions.push_back(
+        static_cast<uint32_t>(offset + __builtin_ctzll(structurals)));
+    structurals &= structurals - 1;
+  }
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/**
+ * @brief This function searches for the first stop byte in the given data
+ *        16 bytes at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param stops This parameter specifies the bytes this function searches for.
+ *
+ * @return The offset of the first stop byte in `data` or `size`
+ */
+__attribute__((target("sse2"))) size_t
+findStopSSE2(char const *data, size_t const size, StopBytes const &stops) {
+  __m128i const first = _mm_set1_epi8(static_cast<char>(stops.bytes[0]));
+  __m128i const second = _mm_set1_epi8(static_cast<char>(stops.bytes[1]));
+  __m128i const third = _mm_set1_epi8(static_cast<char>(stops.bytes[2]));
+  __m128i const fourth = _mm_set1_epi8(static_cast<char>(stops.bytes[3]));
+
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    __m128i const block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + offset));
+    __m128i const matches =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, first),
+                                  _mm_cmpeq_epi8(block, second)),
+                     _mm_or_si128(_mm_cmpeq_epi8(block, third),
+                                  _mm_cmpeq_epi8(block, fourth)));
+    int const mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return offset + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+  return offset + findStopScalar(data + offset, size - offset, stops);
+}
+
+/**
+ * @brief This function counts the code points in the given UTF-8 data 16
+ *        bytes at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ *
+ * @return The number of bytes in `data` that start a code point
+ */
+__attribute__((target("sse2"))) size_t
+countCodePointsSSE2(char const *data, size_t const size) {
+  // Interpreted as signed numbers, continuation bytes (`0x80`–`0xbf`) are
+  // exactly the values smaller than `-64`.
+  __m128i const limit = _mm_set1_epi8(-65);
+
+  size_t codePoints = 0;
+  size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    __m128i const block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + offset));
+    unsigned const mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(block, limit)));
+    codePoints += static_cast<size_t>(__builtin_popcount(mask));
+  }
+  return codePoints + countCodePointsScalar(data + offset, size - offset);
+}
+
+/**
+ * @brief This function searches for the first stop byte in the given data
+ *        32 bytes at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param stops This parameter specifies the bytes this function searches for.
+ *
+ * @return The offset of the first stop byte in `data` or `size`
+ */
+__attribute__((target("avx2"))) size_t
+findStopAVX2(char const *data, size_t const size, StopBytes const &stops) {
+  __m256i const first = _mm256_set1_epi8(static_cast<char>(stops.bytes[0]));
+  __m256i const second = _mm256_set1_epi8(static_cast<char>(stops.bytes[1]));
+  __m256i const third = _mm256_set1_epi8(static_cast<char>(stops.bytes[2]));
+  __m256i const fourth = _mm256_set1_epi8(static_cast<char>(stops.bytes[3]));
+
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    __m256i const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + offset));
+    __m256i const matches =
+        _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, first),
+                                        _mm256_cmpeq_epi8(block, second)),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(block, third),
+                                        _mm256_cmpeq_epi8(block, fourth)));
+    unsigned const mask =
+        static_cast<unsigned>(_mm256_movemask_epi8(matches));
+    if (mask != 0) {
+      return offset + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+  return offset + findStopSSE2(data + offset, size - offset, stops);
+}
+
+/**
+ * @brief This function counts the code points in the given UTF-8 data 32
+ *        bytes at a time.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ *
+ * @return The number of bytes in `data` that start a code point
+ */
+__attribute__((target("avx2,popcnt"))) size_t
+countCodePointsAVX2(char const *data, size_t const size) {
+  __m256i const limit = _mm256_set1_epi8(-65);
+
+  size_t codePoints = 0;
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    __m256i const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + offset));
+    unsigned const mask = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpgt_epi8(block, limit)));
+    codePoints += static_cast<size_t>(__builtin_popcount(mask));
+  }
+  return codePoints + countCodePointsSSE2(data + offset, size - offset);
+}
+
+/**
+ * @brief This function compares 64 bytes with the given character.
+ *
+ * @param block This array stores the bytes this function compares.
+ * @param character This parameter specifies the character this function
+ *                  searches for.
+ *
+ * @return A bitmap that contains a set bit for each occurrence of
+ *         `character` in `block`
+ */
+__attribute__((target("sse2"))) inline uint64_t
+equalMaskSSE2(__m128i const (&block)[4], char const character) {
+  __m128i const needle = _mm_set1_epi8(character);
+  uint64_t mask = 0;
+  for (size_t part = 0; part < 4; part++) {
+    mask |= static_cast<uint64_t>(static_cast<uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(block[part], needle))))
+            << (16 * part);
+  }
+  return mask;
+}
+
+/**
+ * @brief This function classifies the characters of a block using 16 byte
+ *        vectors.
+ *
+ * @param data This pointer stores the start of a block of 64 bytes.
+ *
+ * @return The bitmaps of the block
+ */
+__attribute__((target("sse2"))) inline BlockMasks
+classifySSE2(char const *data) {
+  __m128i const block[4] = {
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(data)),
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + 16)),
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + 32)),
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + 48))};
+  uint64_t const newlines = equalMaskSSE2(block, '\n');
+  return {newlines | equalMaskSSE2(block, '"') | equalMaskSSE2(block, '\'') |
+              equalMaskSSE2(block, '\\'),
+          equalMaskSSE2(block, ':') | equalMaskSSE2(block, '-') |
+              equalMaskSSE2(block, '#'),
+          newlines | equalMaskSSE2(block, ' ')};
+}
+
+/**
+ * @brief This function determines the positions of structural characters
+ *        using 16 byte vectors.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters.
+ */
+__attribute__((target("sse2"))) void
+findStructuralsSSE2(char const *data, size_t const size,
+                    vector<uint32_t> &positions) {
+  size_t offset = 0;
+  for (; offset + 64 <= size; offset += 64) {
+    bool const nextIsWhitespace =
+        offset + 64 < size && isWhitespace(data[offset + 64]);
+    addStructurals(classifySSE2(data + offset), nextIsWhitespace, offset,
+                   positions);
+  }
+  if (offset < size) {
+    char last[64] = {};
+    memcpy(last, data + offset, size - offset);
+    addStructurals(classifySSE2(last), false, offset, positions);
+  }
+}
+
+/**
+ * @brief This function compares 64 bytes with the given character.
+ *
+ * @param block This array stores the bytes this function compares.
+ * @param character This parameter specifies the character this function
+ *                  searches for.
+ *
+ * @return A bitmap that contains a set bit for each occurrence of
+ *         `character` in `block`
+ */
+__attribute__((target("avx2"))) inline uint64_t
+equalMaskAVX2(__m256i const (&block)[2], char const character) {
+  __m256i const needle = _mm256_set1_epi8(character);
+  uint64_t const low = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(block[0], needle)));
+  uint64_t const high = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(block[1], needle)));
+  return low | (high << 32);
+}
+
+/**
+ * @brief This function classifies the characters of a block using 32 byte
+ *        vectors.
+ *
+ * @param data This pointer stores the start of a block of 64 bytes.
+ *
+ * @return The bitmaps of the block
+ */
+__attribute__((target("avx2"))) inline BlockMasks
+classifyAVX2(char const *data) {
+  __m256i const block[2] = {
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data)),
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + 32))};
+  uint64_t const newlines = equalMaskAVX2(block, '\n');
+  return {newlines | equalMaskAVX2(block, '"') | equalMaskAVX2(block, '\'') |
+              equalMaskAVX2(block, '\\'),
+          equalMaskAVX2(block, ':') | equalMaskAVX2(block, '-') |
+              equalMaskAVX2(block, '#'),
+          newlines | equalMaskAVX2(block, ' ')};
+}
+
+/**
+ * @brief This function determines the positions of structural characters
+ *        using 32 byte vectors.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters.
+ */
+__attribute__((target("avx2"))) void
+findStructuralsAVX2(char const *data, size_t const size,
+                    vector<uint32_t> &positions) {
+  size_t offset = 0;
+  for (; offset + 64 <= size; offset += 64) {
+    bool const nextIsWhitespace =
+        offset + 64 < size && isWhitespace(data[offset + 64]);
+    addStructurals(classifyAVX2(data + offset), nextIsWhitespace, offset,
+                   positions);
+  }
+  if (offset < size) {
+    char last[64] = {};
+    memcpy(last, data + offset, size - offset);
+    addStructurals(classifyAVX2(last), false, offset, positions);
+  }
+}
+
+#endif // HAVE_X86_KERNELS
+
+/** This structure stores the implementation of each kernel. */
+struct KernelTable {
+  /** This variable specifies the implementation stored in the table. */
+  Kernels kernels;
+  /** This variable stores the function that searches for stop bytes. */
+  size_t (*findStop)(char const *, size_t const, StopBytes const &);
+  /** This variable stores the function that counts code points. */
+  size_t (*countCodePoints)(char const *, size_t const);
+  /** This variable stores the function that locates structural characters. */
+  void (*findStructurals)(char const *, size_t const, vector<uint32_t> &);
+};
+
+/**
+ * @brief This function returns the kernels for the given implementation.
+ *
+ * @param preferred This parameter specifies the requested implementation.
+ *
+ * @return The kernels of `preferred` or a slower implementation, if the
+ *         processor does not support `preferred`
+ */
+KernelTable selectKernels(Kernels const preferred __attribute__((unused))) {
+#ifdef HAVE_X86_KERNELS
+  __builtin_cpu_init();
+  if (preferred == Kernels::AVX2 && __builtin_cpu_supports("avx2") &&
+      __builtin_cpu_supports("popcnt")) {
+    return {Kernels::AVX2, findStopAVX2, countCodePointsAVX2,
+            findStructuralsAVX2};
+  }
+  if (preferred != Kernels::SCALAR && __builtin_cpu_supports("sse2")) {
+    return {Kernels::SSE2, findStopSSE2, countCodePointsSSE2,
+            findStructuralsSSE2};
+  }
+#endif
+  return {Kernels::SCALAR, findStopScalar, countCodePointsScalar,
+          findStructuralsScalar};
+}
+
+/**
+ * @brief This function returns the kernels currently in use.
+ *
+ * @return A reference to the active kernels
+ */
+KernelTable &activeKernels() {
+  static KernelTable kernels = selectKernels(Kernels::AVX2);
+  return kernels;
+}
+
+} // namespace
+
+/**
+ * @brief This function searches for the first stop byte in the given data.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param stops This parameter specifies the bytes this function searches for.
+ *
+ * @return The offset of the first stop byte in `data` or `size`, if `data`
+ *         does not contain any stop byte
+ */
+size_t findStop(char const *data, size_t const size, StopBytes const &stops) {
+  return activeKernels().findStop(data, size, stops);
+}
+
+/**
+ * @brief This function counts the number of code points in the given UTF-8
+ *        data.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ *
+ * @return The number of bytes in `data` that do not continue a multi-byte
+ *         UTF-8 sequence
+ */
+size_t countCodePoints(char const *data, size_t const size) {
+  return activeKernels().countCodePoints(data, size);
+}
+
+/**
+ * @brief This function determines the positions of all structural characters
+ *        in the given data.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`. The value
+ *             has to be smaller than `2^32`.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters in ascending order, after the function
+ *                  returns.
+ */
+void findStructurals(char const *data, size_t const size,
+                     vector<uint32_t> &positions) {
+  activeKernels().findStructurals(data, size, positions);
+}
+
+/**
+ * @brief This function selects the implementation of the scan kernels.
+ *
+ * @param preferred This parameter specifies the implementation this function
+ *                  should select.
+ *
+ * @return The selected implementation, which might be slower than
+ *         `preferred`, if the processor does not support `preferred`
+ */
+Kernels useKernels(Kernels const preferred) {
+  activeKernels() = selectKernels(preferred);
+  return activeKernels().kernels;
+}
+
+/**
+ * @brief This function returns the name of an implementation of the scan
+ *        kernels.
+ *
+ * @param kernels This parameter specifies an implementation of the kernels.
+ *
+ * @return A text describing `kernels`
+ */
+char const *kernelName(Kernels const kernels) {
+  switch (kernels) {
+  case Kernels::AVX2:
+    return "AVX2";
+  case Kernels::SSE2:
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
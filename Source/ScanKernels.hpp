@@ -0,0 +1,132 @@
+#ifndef SCAN_KERNELS_HPP
+#define SCAN_KERNELS_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::size_t;
+using std::uint32_t;
+using std::vector;
+
+// -- Types --------------------------------------------------------------------
+
+/**
+ * @brief This structure stores up to four bytes, where a scan stops.
+ *
+ * To search for less than four different bytes, repeat one of the bytes.
+ */
+struct StopBytes {
+  /** This array stores the bytes that end a scan. */
+  unsigned char bytes[4];
+
+  /**
+   * @brief This constructor creates a new set of stop bytes.
+   *
+   * @param first This parameter specifies the first stop byte.
+   * @param second This parameter specifies the second stop byte.
+   * @param third This parameter specifies the third stop byte.
+   * @param fourth This parameter specifies the fourth stop byte.
+   */
+  StopBytes(char const first, char const second, char const third,
+            char const fourth);
+
+  /**
+   * @brief This method checks if the given character is a stop byte.
+   *
+   * @param character This parameter stores the character this method checks.
+   *
+   * @retval true If `character` is one of the stop bytes
+   *         false Otherwise
+   */
+  bool contains(size_t const character) const;
+};
+
+/** This enumeration lists the available implementations of the kernels. */
+enum class Kernels { SCALAR, SSE2, AVX2 };
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function searches for the first stop byte in the given data.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ * @param stops This parameter specifies the bytes this function searches for.
+ *
+ * @return The offset of the first stop byte in `data` or `size`, if `data`
+ *         does not contain any stop byte
+ */
+size_t findStop(char const *data, size_t const size, StopBytes const &stops);
+
+/**
+ * @brief This function counts the number of code points in the given UTF-8
+ *        data.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`.
+ *
+ * @return The number of bytes in `data` that do not continue a multi-byte
+ *         UTF-8 sequence
+ */
+size_t countCodePoints(char const *data, size_t const size);
+
+/**
+ * @brief This function determines the positions of all structural characters
+ *        in the given data.
+ *
+ * Structural characters are newlines, quotes (`"` and `'`), backslashes and
+ * the indicators `:`, `-` and `#`, if a space or newline follows them.
+ *
+ * @param data This pointer stores the start of the data this function scans.
+ * @param size This number specifies the number of bytes in `data`. The value
+ *             has to be smaller than `2^32`.
+ * @param positions This vector stores the offsets of all structural
+ *                  characters in ascending order, after the function
+ *                  returns.
+ */
+void findStructurals(char const *data, size_t const size,
+                     vector<uint32_t> &positions);
+
+/**
+ * @brief This function selects the implementation of the scan kernels.
+ *
+ * By default the kernels use the fastest implementation supported by the
+ * processor. Call this function before lexing any data, since it does not
+ * synchronize with other threads.
+ *
+ * @param preferred This parameter specifies the implementation this function
+ *                  should select.
+ *
+ * @return The selected implementation, which might be slower than
+ *         `preferred`, if the processor does not support `preferred`
+ */
+Kernels useKernels(Kernels const preferred);
+
+/**
+ * @brief This function returns the name of an implementation of the scan
+ *        kernels.
+ *
+ * @param kernels This parameter specifies an implementation of the kernels.
+ *
+ * @return A text describing `kernels`
+ */
+char const *kernelName(Kernels const kernels);
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline StopBytes::StopBytes(char const first, char const second,
+                            char const third, char const fourth)
+    : bytes{static_cast<unsigned char>(first),
+            static_cast<unsigned char>(second),
+            static_cast<unsigned char>(third),
+            static_cast<unsigned char>(fourth)} {}
+
+inline bool StopBytes::contains(size_t const character) const {
+  return character == bytes[0] || character == bytes[1] ||
+         character == bytes[2] || character == bytes[3];
+}
+
+#endif // SCAN_KERNELS_HPP
@@ -0,0 +1,55 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <limits>
+
+#include "ScanKernels.hpp"
+#include "StructuralIndex.hpp"
+
+using std::lower_bound;
+using std::numeric_limits;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates an empty index, that is not available.
+ */
+StructuralIndex::StructuralIndex() {}
+
+/**
+ * @brief This constructor creates the structural index for a buffer.
+ *
+ * @param data This pointer stores the start of the UTF-8 encoded buffer.
+ * @param length This number specifies the size of `data` in bytes.
+ */
+StructuralIndex::StructuralIndex(char const *data, size_t const length)
+    : size{length} {
+  if (length >= numeric_limits<uint32_t>::max()) {
+    return;
+  }
+  // Most YAML data contains about one structural character every ten bytes.
+  positions.reserve(length / 8);
+  findStructurals(data, length, positions);
+  indexed = true;
+}
+
+/**
+ * @brief This method returns the position of the next structural character.
+ *
+ * @param start This number specifies the offset, where the search starts.
+ *
+ * @return The offset of the first structural character located at `start` or
+ *         after `start`, or the size of the buffer if there is no such
+ *         character
+ */
+size_t StructuralIndex::next(size_t const start) {
+  if (cursor > 0 && positions[cursor - 1] >= start) {
+    cursor = static_cast<size_t>(
+        lower_bound(positions.begin(), positions.end(), start) -
+        positions.begin());
+  }
+  while (cursor < positions.size() && positions[cursor] < start) {
+    cursor++;
+  }
+  return cursor < positions.size() ? positions[cursor] : size;
+}
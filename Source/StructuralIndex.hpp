@@ -0,0 +1,86 @@
+#ifndef STRUCTURAL_INDEX_HPP
+#define STRUCTURAL_INDEX_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::size_t;
+using std::uint32_t;
+using std::vector;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores the positions of all structural characters of a
+ *        UTF-8 buffer.
+ *
+ * The index is the result of a first stage, that runs before the lexer: A
+ * single (vectorized) pass over the whole input determines the location of
+ * each newline, quote, backslash and each indicator (`:`, `-`, `#`) followed
+ * by a space or newline. The lexer then jumps from one structural character
+ * to the next, instead of inspecting the bytes in between.
+ *
+ * Since the index stores 32 bit offsets, it only supports buffers smaller
+ * than 4 GiB. For larger buffers (and for streams that do not provide direct
+ * access to their data) the index stays empty and `available` returns
+ * `false`.
+ */
+class StructuralIndex {
+  /** This vector stores the offsets of all structural characters. */
+  vector<uint32_t> positions;
+
+  /**
+   * This number stores the position in `positions`, where the last lookup
+   * ended. Since the lexer only moves forward, most lookups start here.
+   */
+  size_t cursor = 0;
+
+  /** This number specifies the size of the indexed buffer. */
+  size_t size = 0;
+
+  /** This boolean specifies if the index contains valid data. */
+  bool indexed = false;
+
+public:
+  /**
+   * @brief This constructor creates an empty index, that is not available.
+   */
+  StructuralIndex();
+
+  /**
+   * @brief This constructor creates the structural index for a buffer.
+   *
+   * @param data This pointer stores the start of the UTF-8 encoded buffer.
+   * @param length This number specifies the size of `data` in bytes.
+   */
+  StructuralIndex(char const *data, size_t const length);
+
+  /**
+   * @brief This method checks if the index can be used to locate structural
+   *        characters.
+   *
+   * @retval true If the index stores the structural characters of the input
+   *         false Otherwise
+   */
+  bool available() const;
+
+  /**
+   * @brief This method returns the position of the next structural character.
+   *
+   * @param start This number specifies the offset, where the search starts.
+   *
+   * @return The offset of the first structural character located at `start`
+   *         or after `start`, or the size of the buffer if there is no such
+   *         character
+   */
+  size_t next(size_t const start);
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline bool StructuralIndex::available() const { return indexed; }
+
+#endif // STRUCTURAL_INDEX_HPP
@@ -0,0 +1,176 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+using std::cref;
+using std::current_exception;
+using std::deque;
+using std::exception_ptr;
+using std::lock_guard;
+using std::mutex;
+using std::ref;
+using std::rethrow_exception;
+using std::thread;
+using std::vector;
+
+// -- Types --------------------------------------------------------------------
+
+namespace {
+
+/** This class stores the tasks of a single worker. */
+class TaskQueue {
+  /** This variable protects `tasks` against concurrent access. */
+  mutex lock;
+
+  /** This variable stores the numbers of the remaining tasks. */
+  deque<size_t> tasks;
+
+public:
+  /**
+   * @brief This method adds a task to the back of the queue.
+   *
+   * @param task This number specifies the task this method adds.
+   */
+  void push(size_t const task) {
+    lock_guard<mutex> guard{lock};
+    tasks.push_back(task);
+  }
+
+  /**
+   * @brief This method removes the task at the front of the queue.
+   *
+   * @param task This variable stores the removed task, if the method
+   *             succeeds.
+   *
+   * @retval true If the method removed a task
+   *         false If the queue is empty
+   */
+  bool pop(size_t &task) {
+    lock_guard<mutex> guard{lock};
+    if (tasks.empty()) {
+      return false;
+    }
+    task = tasks.front();
+    tasks.pop_front();
+    return true;
+  }
+
+  /**
+   * @brief This method removes the task at the back of the queue.
+   *
+   * @param task This variable stores the removed task, if the method
+   *             succeeds.
+   *
+   * @retval true If the method removed a task
+   *         false If the queue is empty
+   */
+  bool steal(size_t &task) {
+    lock_guard<mutex> guard{lock};
+    if (tasks.empty()) {
+      return false;
+    }
+    task = tasks.back();
+    tasks.pop_back();
+    return true;
+  }
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function executes tasks until all queues are empty.
+ *
+ * Since no task adds new tasks, all queues stay empty after the worker failed
+ * to steal a task from each of them.
+ *
+ * @param queues This parameter stores the task queues of all workers.
+ * @param worker This number specifies the worker that executes this function.
+ * @param work This function executes a single task.
+ * @param error This variable stores the exception thrown by `work`, if there
+ *              is any.
+ */
+void runWorker(vector<TaskQueue> &queues, size_t const worker,
+               function<void(size_t, size_t)> const &work,
+               exception_ptr &error) {
+  size_t const workers = queues.size();
+  size_t task;
+  try {
+    while (true) {
+      bool found = queues[worker].pop(task);
+      for (size_t offset = 1; !found && offset < workers; offset++) {
+        found = queues[(worker + offset) % workers].steal(task);
+      }
+      if (!found) {
+        return;
+      }
+      work(worker, task);
+    }
+  } catch (...) {
+    error = current_exception();
+  }
+}
+
+} // namespace
+
+/**
+ * @brief This function returns the number of threads that can run at the
+ *        same time on this machine.
+ *
+ * @return The number of hardware threads, or `1` if the number is unknown
+ */
+size_t hardwareThreads() {
+  size_t const threads = thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+/**
+ * @brief This function runs a fixed number of tasks on a pool of worker
+ *        threads.
+ *
+ * @param tasks This number specifies the number of tasks. The function calls
+ *              `work` once for every number in the range `[0, tasks)`.
+ * @param threads This number specifies the number of workers. The value `0`
+ *                specifies one worker per hardware thread.
+ * @param work This function executes a single task. The first argument
+ *             specifies the number of the worker (in the range
+ *             `[0, threads)`), the second argument the number of the task.
+ *             Calls with the same worker number never run at the same time.
+ *
+ * @throws Exception The first exception thrown by `work`. After a worker
+ *                   catches an exception, it stops processing tasks. The
+ *                   other workers finish the remaining tasks.
+ */
+void runTasks(size_t const tasks, size_t threads,
+              function<void(size_t, size_t)> const &work) {
+  if (threads == 0) {
+    threads = hardwareThreads();
+  }
+
+  vector<TaskQueue> queues(threads);
+  for (size_t task = 0; task < tasks; task++) {
+    queues[task % threads].push(task);
+  }
+
+  vector<exception_ptr> errors(threads);
+  vector<thread> workers;
+  for (size_t worker = 1; worker < threads; worker++) {
+    workers.emplace_back(runWorker, ref(queues), worker, cref(work),
+                         ref(errors[worker]));
+  }
+  runWorker(queues, 0, work, errors[0]);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (auto const &error : errors) {
+    if (error) {
+      rethrow_exception(error);
+    }
+  }
+}
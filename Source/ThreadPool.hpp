@@ -0,0 +1,52 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <functional>
+
+using std::function;
+using std::size_t;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function returns the number of threads that can run at the
+ *        same time on this machine.
+ *
+ * @return The number of hardware threads, or `1` if the number is unknown
+ */
+size_t hardwareThreads();
+
+/**
+ * @brief This function runs a fixed number of tasks on a pool of worker
+ *        threads.
+ *
+ * Each worker owns a queue of tasks. The function distributes the tasks
+ * round-robin over these queues. A worker takes tasks from the front of its
+ * own queue, and steals tasks from the back of other queues, after its own
+ * queue is empty. This way the workers finish the tasks roughly in the order
+ * of their numbers, and a worker that received only small tasks helps the
+ * other workers.
+ *
+ * The calling thread acts as the first worker. The function returns after
+ * the workers finished all tasks.
+ *
+ * @param tasks This number specifies the number of tasks. The function calls
+ *              `work` once for every number in the range `[0, tasks)`.
+ * @param threads This number specifies the number of workers. The value `0`
+ *                specifies one worker per hardware thread.
+ * @param work This function executes a single task. The first argument
+ *             specifies the number of the worker (in the range
+ *             `[0, threads)`), the second argument the number of the task.
+ *             Calls with the same worker number never run at the same time.
+ *
+ * @throws Exception The first exception thrown by `work`. After a worker
+ *                   catches an exception, it stops processing tasks. The
+ *                   other workers finish the remaining tasks.
+ */
+void runTasks(size_t const tasks, size_t threads,
+              function<void(size_t, size_t)> const &work);
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,177 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "TokenPipeline.hpp"
+#include "YAMLLexer.hpp"
+
+using std::current_exception;
+using std::rethrow_exception;
+
+using std::this_thread::yield;
+
+using antlr4::IntStream;
+using antlr4::WritableToken;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new pipeline.
+ *
+ * @param capacity This number specifies the number of tokens the lexer may
+ *                 produce in front of the parser. The value has to be a power
+ *                 of two.
+ */
+template <typename Input>
+TokenPipeline<Input>::TokenPipeline(size_t const capacity) : ring{capacity} {}
+
+/**
+ * @brief This destructor stops the producer thread.
+ */
+template <typename Input> TokenPipeline<Input>::~TokenPipeline() { stop(); }
+
+/**
+ * @brief This method starts a producer thread for the given lexer.
+ *
+ * @param source This parameter stores the lexer the producer runs. The lexer
+ *               has to be prepared for its input already.
+ */
+template <typename Input>
+void TokenPipeline<Input>::start(YAMLLexer<Input> *source) {
+  stop();
+  lexer = source;
+  failure = nullptr;
+  line = 1;
+  column = 0;
+  stopped.store(false, memory_order_relaxed);
+  done.store(false, memory_order_relaxed);
+  producer = thread{&TokenPipeline::produce, this};
+}
+
+/**
+ * @brief This method stops the producer thread and removes all tokens the
+ *        consumer did not read.
+ */
+template <typename Input> void TokenPipeline<Input>::stop() {
+  stopped.store(true, memory_order_relaxed);
+  if (producer.joinable()) {
+    producer.join();
+  }
+  ring.clear();
+}
+
+/**
+ * @brief This method returns the next token of the lexer.
+ *
+ * @return The first token of the ring buffer. If the producer already stopped
+ *         after `EOF`, then the method returns the next token of the lexer.
+ */
+template <typename Input> unique_ptr<Token> TokenPipeline<Input>::nextToken() {
+  unique_ptr<Token> token;
+  while (!ring.pop(token)) {
+    if (done.load(memory_order_acquire)) {
+      // The producer may have added its last token after our first attempt
+      if (ring.pop(token)) {
+        break;
+      }
+      // After the producer stopped, we can use the lexer on this thread
+      stop();
+      if (failure) {
+        rethrow_exception(failure);
+      }
+      token = lexer->nextToken();
+      break;
+    }
+    yield();
+  }
+  line = token->getLine();
+  column = token->getCharPositionInLine();
+  return token;
+}
+
+/**
+ * @brief This method returns the line of the last token.
+ *
+ * @return The line of the token `nextToken` returned last
+ */
+template <typename Input> size_t TokenPipeline<Input>::getLine() const {
+  return line;
+}
+
+/**
+ * @brief This method returns the column of the last token.
+ *
+ * @return The column of the token `nextToken` returned last
+ */
+template <typename Input>
+size_t TokenPipeline<Input>::getCharPositionInLine() {
+  return column;
+}
+
+/**
+ * @brief This method returns the source the lexer is scanning.
+ *
+ * @return The input of the lexer
+ */
+template <typename Input>
+CharStream *TokenPipeline<Input>::getInputStream() {
+  return lexer == nullptr ? nullptr : lexer->getInputStream();
+}
+
+/**
+ * @brief This method retrieves the name of the source the lexer is scanning.
+ *
+ * @return The name of the input of the lexer
+ */
+template <typename Input> std::string TokenPipeline<Input>::getSourceName() {
+  return lexer == nullptr ? IntStream::UNKNOWN_SOURCE_NAME
+                          : lexer->getSourceName();
+}
+
+/**
+ * @brief This method returns the token factory of the lexer.
+ *
+ * @return The factory the parser uses to create tokens for missing input
+ */
+template <typename Input>
+Ref<TokenFactory<CommonToken>> TokenPipeline<Input>::getTokenFactory() {
+  return lexer == nullptr ? CommonTokenFactory::DEFAULT
+                          : lexer->getTokenFactory();
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method moves the tokens of the lexer into the ring buffer.
+ */
+template <typename Input> void TokenPipeline<Input>::produce() {
+  LineIndex const &positions = lexer->getLineIndex();
+  try {
+    bool last = false;
+    while (!last && !stopped.load(memory_order_relaxed)) {
+      unique_ptr<Token> token = lexer->nextToken();
+      last = token->getType() == Token::EOF;
+
+      // Store the position, which the token would otherwise compute from the
+      // line index on the consumer thread
+      size_t const start = token->getStartIndex();
+      if (start != INVALID_INDEX) {
+        WritableToken *writable = static_cast<WritableToken *>(token.get());
+        writable->setLine(positions.line(start));
+        writable->setCharPositionInLine(positions.column(start));
+      }
+
+      while (!ring.push(token) && !stopped.load(memory_order_relaxed)) {
+        yield();
+      }
+    }
+  } catch (...) {
+    failure = current_exception();
+  }
+  done.store(true, memory_order_release);
+}
+
+// -- Instantiations -----------------------------------------------------------
+
+template class TokenPipeline<CharStream>;
+template class TokenPipeline<BufferStream>;
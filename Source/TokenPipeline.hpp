@@ -0,0 +1,172 @@
+#ifndef TOKEN_PIPELINE_HPP
+#define TOKEN_PIPELINE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "BufferStream.hpp"
+#include "TokenRing.hpp"
+
+using std::atomic;
+using std::exception_ptr;
+using std::thread;
+
+using antlr4::CharStream;
+using antlr4::CommonToken;
+using antlr4::TokenFactory;
+using antlr4::TokenSource;
+
+// -- Types --------------------------------------------------------------------
+
+// The header of the lexer does not use an include guard
+template <typename Input> class YAMLLexer;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class runs a lexer on a thread of its own and provides its
+ *        tokens to a parser on another thread.
+ *
+ * After `start`, a producer thread calls `nextToken` of the lexer and stores
+ * the tokens in a lock-free ring buffer, until the lexer emits `EOF`. The
+ * parser reads the tokens from the ring buffer through the `TokenSource`
+ * interface of this class. This way the lexer scans the input, while the
+ * parser processes the tokens in front of it.
+ *
+ * Tokens of the lexer usually compute their position from the line index of
+ * the lexer, which the producer thread extends while it scans the input. The
+ * producer therefore stores the position of each token explicitly, before it
+ * passes the token on. The consumer must not access the line index of the
+ * lexer, until the producer stopped.
+ *
+ * If the lexer fails, then the producer stops and `nextToken` rethrows the
+ * exception of the lexer, after the consumer received all previous tokens.
+ * The parser therefore sees a lexer error at the same position as without a
+ * pipeline.
+ *
+ * @tparam Input This type specifies the character stream the lexer scans.
+ */
+template <typename Input> class TokenPipeline : public TokenSource {
+  /** This variable stores the lexer the producer thread runs. */
+  YAMLLexer<Input> *lexer = nullptr;
+
+  /** This variable stores the tokens the consumer did not read yet. */
+  TokenRing ring;
+
+  /** This variable stores the producer thread. */
+  thread producer;
+
+  /** This variable tells the producer to stop, even if the ring is full. */
+  atomic<bool> stopped{false};
+
+  /** This variable specifies if the producer emitted its last token. */
+  atomic<bool> done{false};
+
+  /**
+   * This variable stores the exception of the lexer, if the lexer failed.
+   * Only the producer writes this value, before it sets `done`.
+   */
+  exception_ptr failure;
+
+  /** This variable stores the line of the last token the consumer read. */
+  size_t line = 1;
+
+  /** This variable stores the column of the last token the consumer read. */
+  size_t column = 0;
+
+  /**
+   * @brief This method moves the tokens of the lexer into the ring buffer.
+   *
+   * The producer thread executes this method.
+   */
+  void produce();
+
+public:
+  /**
+   * @brief This constructor creates a new pipeline.
+   *
+   * @param capacity This number specifies the number of tokens the lexer may
+   *                 produce in front of the parser. The value has to be a
+   *                 power of two.
+   */
+  TokenPipeline(size_t const capacity = 1024);
+
+  /**
+   * @brief This destructor stops the producer thread.
+   */
+  ~TokenPipeline();
+
+  /**
+   * @brief This method starts a producer thread for the given lexer.
+   *
+   * The method stops the producer of the last input first.
+   *
+   * @param source This parameter stores the lexer the producer runs. The
+   *               lexer has to be prepared for its input already.
+   */
+  void start(YAMLLexer<Input> *source);
+
+  /**
+   * @brief This method stops the producer thread and removes all tokens the
+   *        consumer did not read.
+   *
+   * Afterwards the calling thread may access the lexer directly.
+   */
+  void stop();
+
+  /**
+   * @brief This method returns the next token of the lexer.
+   *
+   * @return The first token of the ring buffer. If the producer already
+   *         stopped after `EOF`, then the method returns the next token of
+   *         the lexer.
+   *
+   * @throws ParseCancellationException If the lexer was unable to tokenize
+   *                                    the input in front of the next token
+   */
+  unique_ptr<Token> nextToken() override;
+
+  /**
+   * @brief This method returns the line of the last token.
+   *
+   * @return The line of the token `nextToken` returned last
+   */
+  size_t getLine() const override;
+
+  /**
+   * @brief This method returns the column of the last token.
+   *
+   * @return The column of the token `nextToken` returned last
+   */
+  size_t getCharPositionInLine() override;
+
+  /**
+   * @brief This method returns the source the lexer is scanning.
+   *
+   * @return The input of the lexer
+   */
+  CharStream *getInputStream() override;
+
+  /**
+   * @brief This method retrieves the name of the source the lexer is
+   *        scanning.
+   *
+   * @return The name of the input of the lexer
+   */
+  std::string getSourceName() override;
+
+  /**
+   * @brief This method returns the token factory of the lexer.
+   *
+   * @return The factory the parser uses to create tokens for missing input
+   */
+  Ref<TokenFactory<CommonToken>> getTokenFactory() override;
+};
+
+extern template class TokenPipeline<CharStream>;
+extern template class TokenPipeline<BufferStream>;
+
+#endif // TOKEN_PIPELINE_HPP
@@ -0,0 +1,85 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "TokenQueue.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new empty queue.
+ *
+ * @param capacity This number specifies the initial number of slots. The
+ *                 value has to be a power of two.
+ */
+TokenQueue::TokenQueue(size_t const capacity) : slots(capacity) {}
+
+/**
+ * @brief This method checks if the queue contains a token in front of the
+ *        given position.
+ *
+ * @param position This number specifies an absolute position of a slot.
+ *
+ * @retval true If `pop` would return a token stored in front of `position`
+ *         false Otherwise
+ */
+bool TokenQueue::containsBefore(size_t const position) const {
+  for (size_t current = head; current < position; current++) {
+    if (slot(current) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief This method returns the absolute position of the first slot.
+ *
+ * @return The position of the first slot in the queue
+ */
+size_t TokenQueue::begin() const { return head; }
+
+/**
+ * @brief This method returns the absolute position after the last slot.
+ *
+ * @return The position after the last slot in the queue
+ */
+size_t TokenQueue::end() const { return tail; }
+
+/**
+ * @brief This method returns the token stored at the given position.
+ *
+ * @param position This number specifies the absolute position of a slot
+ *                 between `begin()` (inclusive) and `end()` (exclusive).
+ *
+ * @return The token at `position` or `nullptr`, if the slot is empty
+ */
+YAMLToken const *TokenQueue::at(size_t const position) const {
+  return slot(position).get();
+}
+
+/**
+ * @brief This method removes all tokens from the queue.
+ */
+void TokenQueue::clear() {
+  for (auto &token : slots) {
+    token.reset();
+  }
+  head = tail = filled = 0;
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method doubles the capacity of the ring buffer.
+ *
+ * Since we compute the index of a slot from its absolute position, we have to
+ * move every slot to its location in the larger buffer.
+ */
+void TokenQueue::grow() {
+  vector<unique_ptr<YAMLToken>> larger(slots.size() * 2);
+  for (size_t position = head; position < tail; position++) {
+    larger[position & (larger.size() - 1)] = move(slot(position));
+  }
+  slots.swap(larger);
+}
@@ -0,0 +1,200 @@
+#ifndef TOKEN_QUEUE_HPP
+#define TOKEN_QUEUE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+
+#include "YAMLToken.hpp"
+
+using std::unique_ptr;
+using std::vector;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores the tokens the lexer did not emit yet.
+ *
+ * The queue is a ring buffer. Besides adding tokens at the end, the lexer can
+ * reserve empty slots at the end of the queue and fill them later. This way
+ * the lexer is able to add the `MAPPING START` and `KEY` token of a simple key
+ * candidate in constant time, after it found the corresponding `VALUE` token.
+ *
+ * Every slot has an absolute position, which does not change when the buffer
+ * grows or the queue removes tokens from its front. Slots that were reserved,
+ * but never filled, are skipped when the lexer removes tokens from the queue.
+ */
+class TokenQueue {
+  /**
+   * This vector stores the slots of the ring buffer. Its size is always a
+   * power of two.
+   */
+  vector<unique_ptr<YAMLToken>> slots;
+
+  /** This number stores the absolute position of the first slot. */
+  size_t head = 0;
+
+  /** This number stores the absolute position after the last slot. */
+  size_t tail = 0;
+
+  /** This number stores the number of slots that contain a token. */
+  size_t filled = 0;
+
+  /**
+   * @brief This method doubles the capacity of the ring buffer.
+   */
+  void grow();
+
+  /**
+   * @brief This method returns the slot at the given absolute position.
+   *
+   * @param position This number specifies the absolute position of the slot.
+   *
+   * @return The slot at `position`
+   */
+  unique_ptr<YAMLToken> &slot(size_t const position);
+
+  /**
+   * @brief This method returns the slot at the given absolute position.
+   *
+   * @param position This number specifies the absolute position of the slot.
+   *
+   * @return The slot at `position`
+   */
+  unique_ptr<YAMLToken> const &slot(size_t const position) const;
+
+public:
+  /**
+   * @brief This constructor creates a new empty queue.
+   *
+   * @param capacity This number specifies the initial number of slots. The
+   *                 value has to be a power of two.
+   */
+  TokenQueue(size_t const capacity = 64);
+
+  /**
+   * @brief This method adds a token to the end of the queue.
+   *
+   * @param token This parameter stores the token this method adds.
+   */
+  void push(unique_ptr<YAMLToken> token);
+
+  /**
+   * @brief This method adds an empty slot to the end of the queue.
+   *
+   * @return The absolute position of the new slot
+   */
+  size_t reserve();
+
+  /**
+   * @brief This method stores a token in a slot added by `reserve`.
+   *
+   * @param position This number specifies the absolute position of the
+   *                 slot. The slot must not have been removed from the queue.
+   * @param token This parameter stores the token this method saves.
+   */
+  void fill(size_t const position, unique_ptr<YAMLToken> token);
+
+  /**
+   * @brief This method removes the first token from the queue.
+   *
+   * The method skips all empty slots located in front of the first token.
+   * Calling this method on an empty queue is undefined.
+   *
+   * @return The first token of the queue
+   */
+  unique_ptr<YAMLToken> pop();
+
+  /**
+   * @brief This method checks if the queue contains any tokens.
+   *
+   * @retval true If the queue does not contain a token
+   *         false Otherwise
+   */
+  bool empty() const;
+
+  /**
+   * @brief This method checks if the queue contains a token in front of the
+   *        given position.
+   *
+   * @param position This number specifies an absolute position of a slot.
+   *
+   * @retval true If `pop` would return a token stored in front of `position`
+   *         false Otherwise
+   */
+  bool containsBefore(size_t const position) const;
+
+  /**
+   * @brief This method returns the absolute position of the first slot.
+   *
+   * @return The position of the first slot in the queue
+   */
+  size_t begin() const;
+
+  /**
+   * @brief This method returns the absolute position after the last slot.
+   *
+   * @return The position after the last slot in the queue
+   */
+  size_t end() const;
+
+  /**
+   * @brief This method returns the token stored at the given position.
+   *
+   * @param position This number specifies the absolute position of a slot
+   *                 between `begin()` (inclusive) and `end()` (exclusive).
+   *
+   * @return The token at `position` or `nullptr`, if the slot is empty
+   */
+  YAMLToken const *at(size_t const position) const;
+
+  /**
+   * @brief This method removes all tokens from the queue.
+   */
+  void clear();
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline unique_ptr<YAMLToken> &TokenQueue::slot(size_t const position) {
+  return slots[position & (slots.size() - 1)];
+}
+
+inline unique_ptr<YAMLToken> const &
+TokenQueue::slot(size_t const position) const {
+  return slots[position & (slots.size() - 1)];
+}
+
+inline void TokenQueue::push(unique_ptr<YAMLToken> token) {
+  if (tail - head == slots.size()) {
+    grow();
+  }
+  slot(tail++) = move(token);
+  filled++;
+}
+
+inline size_t TokenQueue::reserve() {
+  if (tail - head == slots.size()) {
+    grow();
+  }
+  return tail++;
+}
+
+inline void TokenQueue::fill(size_t const position,
+                             unique_ptr<YAMLToken> token) {
+  slot(position) = move(token);
+  filled++;
+}
+
+inline unique_ptr<YAMLToken> TokenQueue::pop() {
+  while (slot(head) == nullptr) {
+    head++;
+  }
+  filled--;
+  return move(slot(head++));
+}
+
+inline bool TokenQueue::empty() const { return filled == 0; }
+
+#endif // TOKEN_QUEUE_HPP
@@ -0,0 +1,25 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "TokenRing.hpp"
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new empty ring buffer.
+ *
+ * @param capacity This number specifies the number of slots. The value has to
+ *                 be a power of two.
+ */
+TokenRing::TokenRing(size_t const capacity) : slots(capacity) {}
+
+/**
+ * @brief This method removes all tokens from the buffer.
+ */
+void TokenRing::clear() {
+  for (auto &token : slots) {
+    token.reset();
+  }
+  head.store(0, memory_order_relaxed);
+  tail.store(0, memory_order_relaxed);
+  knownHead = knownTail = 0;
+}
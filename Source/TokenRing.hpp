@@ -0,0 +1,132 @@
+#ifndef TOKEN_RING_HPP
+#define TOKEN_RING_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <antlr4-runtime.h>
+
+using std::atomic;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+using std::size_t;
+using std::unique_ptr;
+using std::vector;
+
+using antlr4::Token;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class passes tokens from one thread to another.
+ *
+ * The ring buffer has a fixed capacity and supports exactly one producer
+ * thread (calling `push`) and one consumer thread (calling `pop`). Both
+ * methods never block and never lock: The producer only writes `tail`, the
+ * consumer only writes `head`. A slot belongs to the producer, until the
+ * producer publishes it by advancing `tail`. Afterwards it belongs to the
+ * consumer, until the consumer releases it by advancing `head`.
+ *
+ * Each side also keeps a copy of the position of the other side. It only
+ * reloads the shared position, if its copy indicates that the buffer is full
+ * (or empty). This way the cache line of the other side moves between the
+ * cores only once for multiple tokens.
+ */
+class TokenRing {
+  /**
+   * This vector stores the slots of the ring buffer. Its size is always a
+   * power of two.
+   */
+  vector<unique_ptr<Token>> slots;
+
+  /** This number stores the absolute position of the next token to pop. */
+  atomic<size_t> head{0};
+
+  /** This number stores the consumer’s copy of `tail`. */
+  size_t knownTail = 0;
+
+  /** This padding moves the variables of the producer to another cache line. */
+  char padding[64] __attribute__((unused));
+
+  /** This number stores the absolute position of the next free slot. */
+  atomic<size_t> tail{0};
+
+  /** This number stores the producer’s copy of `head`. */
+  size_t knownHead = 0;
+
+public:
+  /**
+   * @brief This constructor creates a new empty ring buffer.
+   *
+   * @param capacity This number specifies the number of slots. The value has
+   *                 to be a power of two.
+   */
+  TokenRing(size_t const capacity = 1024);
+
+  /**
+   * @brief This method adds a token to the end of the buffer.
+   *
+   * Only the producer thread may call this method.
+   *
+   * @param token This parameter stores the token this method adds. If the
+   *              method fails, then the parameter still owns the token.
+   *
+   * @retval true If the method added the token
+   *         false If the buffer is full
+   */
+  bool push(unique_ptr<Token> &token);
+
+  /**
+   * @brief This method removes the first token from the buffer.
+   *
+   * Only the consumer thread may call this method.
+   *
+   * @param token This variable stores the removed token, if the method
+   *              succeeds.
+   *
+   * @retval true If the method removed a token
+   *         false If the buffer is empty
+   */
+  bool pop(unique_ptr<Token> &token);
+
+  /**
+   * @brief This method removes all tokens from the buffer.
+   *
+   * Call this method only while no other thread uses the buffer.
+   */
+  void clear();
+};
+
+// -- Inline Methods -----------------------------------------------------------
+
+inline bool TokenRing::push(unique_ptr<Token> &token) {
+  size_t const position = tail.load(memory_order_relaxed);
+  if (position - knownHead == slots.size()) {
+    knownHead = head.load(memory_order_acquire);
+    if (position - knownHead == slots.size()) {
+      return false;
+    }
+  }
+  slots[position & (slots.size() - 1)] = move(token);
+  tail.store(position + 1, memory_order_release);
+  return true;
+}
+
+inline bool TokenRing::pop(unique_ptr<Token> &token) {
+  size_t const position = head.load(memory_order_relaxed);
+  if (position == knownTail) {
+    knownTail = tail.load(memory_order_acquire);
+    if (position == knownTail) {
+      return false;
+    }
+  }
+  token = move(slots[position & (slots.size() - 1)]);
+  head.store(position + 1, memory_order_release);
+  return true;
+}
+
+#endif // TOKEN_RING_HPP
@@ -0,0 +1,56 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "TwoStageParser.hpp"
+
+using std::make_shared;
+
+using antlr4::BailErrorStrategy;
+using antlr4::DefaultErrorStrategy;
+using antlr4::ParseCancellationException;
+using antlr4::atn::ParserATNSimulator;
+using antlr4::atn::PredictionMode;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function parses a token stream using two-stage prediction.
+ *
+ * @param parser This parameter stores the parser this function uses.
+ * @param tokens This parameter stores the token stream of `parser`.
+ * @param errorListener This parameter stores the listener that receives the
+ *                      syntax errors of the second stage.
+ * @param restart This function will be called before the second stage starts.
+ * @param prefetch This boolean specifies if the function reads all tokens,
+ *                 before it starts parsing.
+ *
+ * @return The parse tree for the input
+ */
+ParseTree *parseTwoStage(YAML &parser, CommonTokenStream &tokens,
+                         ANTLRErrorListener &errorListener,
+                         function<void()> const &restart,
+                         bool const prefetch) {
+  if (prefetch) {
+    tokens.fill(); // Lexer errors have to happen before the first stage
+  }
+
+  ParserATNSimulator *interpreter =
+      parser.getInterpreter<ParserATNSimulator>();
+  interpreter->setPredictionMode(PredictionMode::SLL);
+  parser.removeErrorListeners();
+  parser.setErrorHandler(make_shared<BailErrorStrategy>());
+  try {
+    return parser.yaml();
+  } catch (ParseCancellationException const &) {
+    // The input is either invalid, or SLL prediction is not powerful enough
+    // to parse it. The second stage determines which of the two is the case.
+  }
+
+  if (restart) {
+    restart();
+  }
+  parser.setErrorHandler(make_shared<DefaultErrorStrategy>());
+  parser.addErrorListener(&errorListener);
+  interpreter->setPredictionMode(PredictionMode::LL);
+  parser.reset();
+  return parser.yaml();
+}
@@ -0,0 +1,61 @@
+#ifndef TWO_STAGE_PARSER_HPP
+#define TWO_STAGE_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <functional>
+
+#include <antlr4-runtime.h>
+
+#include "YAML.h"
+
+using std::function;
+
+using antlr4::ANTLRErrorListener;
+using antlr4::CommonTokenStream;
+using ParseTree = antlr4::tree::ParseTree;
+
+using antlr::YAML;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function parses a token stream using two-stage prediction.
+ *
+ * The first stage uses the fast SLL prediction mode together with an error
+ * strategy that cancels the parsing process at the first error. This stage
+ * succeeds for (almost) all valid input. Only if it fails, the function
+ * rewinds the token stream and parses it again using full LL prediction and
+ * the default error strategy, which reports errors to `errorListener`.
+ *
+ * The lexer also cancels the parsing process with a
+ * `ParseCancellationException`, if it is unable to tokenize the input. To
+ * distinguish these errors from a failure of the first stage, the function
+ * reads all tokens before it starts parsing. Lexer errors therefore propagate
+ * to the caller, before the parser consumes any token. If `prefetch` is
+ * `false`, then the parser reads the tokens while it parses the input. A
+ * lexer error then also cancels the first stage. The second stage runs into
+ * the same error, as long as the token source reports it again, and the error
+ * propagates to the caller.
+ *
+ * Parse listeners attached to `parser` receive the events of both stages. If
+ * the first stage fails, then the function calls `restart` before it starts
+ * the second stage. This way listeners can discard the data they collected
+ * during the first stage.
+ *
+ * @param parser This parameter stores the parser this function uses.
+ * @param tokens This parameter stores the token stream of `parser`.
+ * @param errorListener This parameter stores the listener that receives the
+ *                      syntax errors of the second stage.
+ * @param restart This function will be called before the second stage starts.
+ * @param prefetch This boolean specifies if the function reads all tokens,
+ *                 before it starts parsing.
+ *
+ * @return The parse tree for the input
+ */
+ParseTree *parseTwoStage(YAML &parser, CommonTokenStream &tokens,
+                         ANTLRErrorListener &errorListener,
+                         function<void()> const &restart = nullptr,
+                         bool const prefetch = true);
+
+#endif // TWO_STAGE_PARSER_HPP
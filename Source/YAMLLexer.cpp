@@ -18,13 +18,277 @@
 #include "YAMLLexer.hpp"
 
 using std::make_pair;
+using std::make_shared;
+using std::min;
 
 using antlr4::ParseCancellationException;
 
-using spdlog::set_level;
-using spdlog::set_pattern;
-using spdlog::stderr_color_mt;
-using spdlog::level::trace;
+using spdlog::sinks_init_list;
+using spdlog::sinks::stderr_color_sink_mt;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function returns the text the line index of a generic lexer
+ *        refers to.
+ *
+ * The generic lexer uses code point indices. The line index therefore does not
+ * need access to the text.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ *
+ * @return `nullptr`
+ */
+char const *indexedText(CharStream *input __attribute__((unused))) {
+  return nullptr;
+}
+
+/**
+ * @brief This function returns the text the line index of a buffer lexer
+ *        refers to.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ *
+ * @return The UTF-8 data of `input`
+ */
+char const *indexedText(BufferStream *input) { return input->data(); }
+
+/**
+ * @brief This function returns the structural index for the input of a
+ *        generic lexer.
+ *
+ * A generic character stream does not provide access to its data. The
+ * generic lexer therefore does not use a structural index.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ *
+ * @return An index that is not available
+ */
+StructuralIndex indexStructurals(CharStream *input __attribute__((unused))) {
+  return StructuralIndex{};
+}
+
+/**
+ * @brief This function creates the structural index for the input of a
+ *        buffer lexer.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ *
+ * @return The structural index of the data stored in `input`
+ */
+StructuralIndex indexStructurals(BufferStream *input) {
+  return StructuralIndex{input->data(), input->size()};
+}
+
+/**
+ * @brief This function tells the input of a lexer that the lexer does not
+ *        need the characters in front of the given position any more.
+ *
+ * A generic character stream keeps its whole input in memory. The function
+ * therefore does nothing.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ * @param index This number specifies the index of the first character the
+ *              lexer might still access.
+ *
+ * @return `false`
+ */
+bool discard(CharStream *input __attribute__((unused)),
+             size_t const index __attribute__((unused))) {
+  return false;
+}
+
+/**
+ * @brief This function tells the input of a lexer that the lexer does not
+ *        need the characters in front of the given position any more.
+ *
+ * @param input This parameter specifies the stream the lexer scans.
+ * @param index This number specifies the index of the first character the
+ *              lexer might still access.
+ *
+ * @return `true`
+ */
+bool discard(ChunkStream *input, size_t const index) {
+  input->discard(index);
+  return true;
+}
+
+/**
+ * A lexer for a sliding window rotates the arenas of its token factory after
+ * this number of tokens.
+ */
+size_t const TOKENS_PER_GENERATION = 4096;
+
+/** A plain scalar might end at these characters. */
+StopBytes const PLAIN_STOPS{' ', '\n', ':', '#'};
+
+/** A single quoted scalar might end at these characters. */
+StopBytes const SINGLE_QUOTED_STOPS{'\'', '\n', '\'', '\n'};
+
+/** A double quoted scalar might end at these characters. */
+StopBytes const DOUBLE_QUOTED_STOPS{'"', '\\', '\n', '"'};
+
+/** A comment ends at these characters. */
+StopBytes const COMMENT_STOPS{'\n', '\n', '\n', '\n'};
+
+/**
+ * @brief This function counts the characters in front of the next stop
+ *        character.
+ *
+ * The generic lexer has to check every character separately.
+ *
+ * @tparam Input This type specifies the character stream this function scans.
+ *
+ * @param input This parameter specifies the stream this function scans.
+ * @param offset This number specifies the lookahead offset (`1` is the
+ *               current character), where this function starts to search.
+ * @param stops This parameter specifies the characters this function searches
+ *              for.
+ *
+ * @return The number of characters between `offset` and the next stop
+ *         character (or the end of the input)
+ */
+template <typename Input>
+size_t searchStop(Input *input, size_t const offset, StopBytes const &stops) {
+  size_t lookahead = offset;
+  for (size_t character = input->LA(lookahead);
+       character != Token::EOF && !stops.contains(character);
+       character = input->LA(++lookahead)) {
+  }
+  return lookahead - offset;
+}
+
+/**
+ * @brief This function counts the characters in front of the next stop
+ *        character.
+ *
+ * A buffer stream provides direct access to its data. This function
+ * therefore uses the (vectorized) scan kernels to search for the stop
+ * characters.
+ *
+ * @param input This parameter specifies the stream this function scans.
+ * @param offset This number specifies the lookahead offset (`1` is the
+ *               current character), where this function starts to search.
+ * @param stops This parameter specifies the characters this function searches
+ *              for.
+ *
+ * @return The number of characters between `offset` and the next stop
+ *         character (or the end of the input)
+ */
+size_t searchStop(BufferStream *input, size_t const offset,
+                  StopBytes const &stops) {
+  size_t const remaining = input->remaining();
+  if (offset > remaining) {
+    return 0;
+  }
+  return findStop(input->current() + offset - 1, remaining - offset + 1,
+                  stops);
+}
+
+/**
+ * @brief This function consumes the given number of characters.
+ *
+ * @tparam Input This type specifies the character stream this function
+ *               advances.
+ *
+ * @param input This parameter specifies the stream this function advances.
+ * @param characters This number specifies the number of characters this
+ *                   function consumes.
+ */
+template <typename Input>
+void advance(Input *input, size_t const characters) {
+  for (size_t charsLeft = characters; charsLeft > 0; charsLeft--) {
+    input->consume();
+  }
+}
+
+/**
+ * @brief This function consumes the given number of bytes.
+ *
+ * @param input This parameter specifies the stream this function advances.
+ * @param characters This number specifies the number of bytes this function
+ *                   consumes.
+ */
+void advance(BufferStream *input, size_t const characters) {
+  input->skip(characters);
+}
+
+/**
+ * @brief This function checks if the escape sequence at the current position
+ *        of the input specifies the null character.
+ *
+ * Elektra stores values and base names as null terminated strings. A null
+ * character would silently cut off the rest of the scalar.
+ *
+ * @param input This parameter specifies the stream this function checks. Its
+ *              current character has to be a backslash.
+ *
+ * @retval true If the escape sequence is `\0`, `\x00`, `\u0000` or
+ *              `\U00000000`
+ *         false Otherwise
+ */
+template <typename Input> bool isNullEscape(Input *input) {
+  size_t digits = 0;
+  switch (input->LA(2)) {
+  case '0':
+    return true;
+  case 'x':
+    digits = 2;
+    break;
+  case 'u':
+    digits = 4;
+    break;
+  case 'U':
+    digits = 8;
+    break;
+  default:
+    return false;
+  }
+  for (ssize_t offset = 3; offset < 3 + static_cast<ssize_t>(digits);
+       offset++) {
+    if (input->LA(offset) != '0') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief This function returns the logger of all lexers that do not print
+ *        any messages.
+ *
+ * The logger has no sinks and does not belong to the registry of `spdlog`.
+ * Since C++11 guarantees a thread-safe initialization of the static variable,
+ * lexers on different threads can share this logger.
+ *
+ * @return A logger that discards all messages
+ */
+shared_ptr<logger> const &silentLogger() {
+  static shared_ptr<logger> const silent =
+      make_shared<logger>("lexer", sinks_init_list{});
+  return silent;
+}
+
+} // namespace
+
+/**
+ * @brief This function creates a logger that prints the trace messages of a
+ *        lexer to the standard error output.
+ *
+ * The function does not add the logger to the registry of `spdlog`. A program
+ * can therefore create as many of these loggers as it needs.
+ *
+ * @return A new logger for trace messages
+ */
+shared_ptr<logger> createTraceLogger() {
+  auto console =
+      make_shared<logger>("lexer", make_shared<stderr_color_sink_mt>());
+  console->set_pattern("[%H:%M:%S:%e] %v ");
+  console->set_level(spdlog::level::trace);
+  return console;
+}
 
 // -- Class --------------------------------------------------------------------
 
@@ -32,15 +296,42 @@ using spdlog::level::trace;
  * @brief This constructor creates a new YAML lexer for the given input.
  *
  * @param input This character stream stores the data this lexer scans.
+ * @param output This parameter stores the logger that receives the trace
+ *               messages of the lexer. If this parameter is `nullptr`, then
+ *               the lexer does not print any messages.
  */
-YAMLLexer::YAMLLexer(CharStream *input) {
-  set_pattern("[%H:%M:%S:%e] %v ");
-  set_level(trace);
-  console = stderr_color_mt("console");
+template <typename Input>
+YAMLLexer<Input>::YAMLLexer(Input *input, shared_ptr<logger> output)
+    : console{output ? output : silentLogger()} {
   LOG("Init lexer");
 
-  this->input = input;
-  this->source = make_pair(this, input);
+  reset(input);
+}
+
+/**
+ * @brief This method prepares the lexer to scan a new input.
+ *
+ * @param stream This character stream stores the data this lexer scans.
+ */
+template <typename Input> void YAMLLexer<Input>::reset(Input *stream) {
+  LOG("Reset lexer");
+
+  // The queue and the simple key candidate store tokens of the last input,
+  // which we have to destroy before we release their memory
+  tokens.clear();
+  simpleKey = make_pair(nullptr, 0);
+  arenaFactory.reset();
+  generation = 0;
+  emitted = make_pair(0, 0);
+
+  columnCache = make_pair(0, 1);
+  indents = stack<size_t>{deque<size_t>{0}};
+  done = false;
+
+  input = stream;
+  source = make_pair(this, stream);
+  positions = LineIndex{indexedText(stream)};
+  structurals = indexStructurals(stream);
   scanStart();
 }
 
@@ -50,13 +341,17 @@ YAMLLexer::YAMLLexer(CharStream *input) {
  * @retval true If the lexer should fetch additional tokens
  *         false Otherwise
  */
-bool YAMLLexer::needMoreTokens() const {
+template <typename Input>
+bool YAMLLexer<Input>::needMoreTokens() const {
   if (done) {
     return false;
   }
 
-  bool keyCandidateExists = simpleKey.first != nullptr;
-  return keyCandidateExists || tokens.empty();
+  // The lexer can emit the tokens in front of the slots reserved for a simple
+  // key candidate, since the candidate does not change them
+  bool waitForKey = simpleKey.first != nullptr &&
+                    !tokens.containsBefore(simpleKey.second - 1);
+  return waitForKey || tokens.empty();
 }
 
 /**
@@ -65,25 +360,32 @@ bool YAMLLexer::needMoreTokens() const {
  *
  * @return A token of the token stream produced by the lexer
  */
-unique_ptr<Token> YAMLLexer::nextToken() {
+template <typename Input>
+unique_ptr<Token> YAMLLexer<Input>::nextToken() {
   LOG("Retrieve next token");
+  release();
   while (needMoreTokens()) {
     fetchTokens();
-    LOG("Tokens:");
-    for (unique_ptr<CommonToken> const &token : tokens) {
-      LOGF("\t {}", token->toString());
+#ifdef HAVE_TRACE
+    if (console->should_log(spdlog::level::trace)) {
+      LOG("Tokens:");
+      for (size_t position = tokens.begin(); position < tokens.end();
+           position++) {
+        if (tokens.at(position) != nullptr) {
+          LOGF("\t {}", tokens.at(position)->toString());
+        }
+      }
     }
+#endif
   }
 
   // If `fetchTokens` was unable to retrieve a token (error condition), we emit
   // `EOF`.
-  if (tokens.size() <= 0) {
-    tokens.push_back(
-        commonToken(Token::EOF, input->index(), input->index(), "EOF"));
+  if (tokens.empty()) {
+    tokens.push(commonToken(Token::EOF, input->index(), input->index(), "EOF"));
   }
-  unique_ptr<CommonToken> token = move(tokens.front());
-  tokens.pop_front();
-  tokensEmitted++;
+  unique_ptr<YAMLToken> token = tokens.pop();
+  emitted = make_pair(tokens.begin() - 1, token->getStartIndex());
   LOGF("Emit token {}", token->toString());
   return token;
 }
@@ -93,21 +395,36 @@ unique_ptr<Token> YAMLLexer::nextToken() {
  *
  * @return The index of the line the lexer is currently scanning
  */
-size_t YAMLLexer::getLine() const { return line; }
+template <typename Input>
+size_t YAMLLexer<Input>::getLine() const { return positions.lines(); }
+
+/**
+ * @brief This method returns the line index of the lexer.
+ *
+ * @return An index that maps input positions to line and column numbers
+ */
+template <typename Input>
+LineIndex const &YAMLLexer<Input>::getLineIndex() const {
+  return positions;
+}
 
 /**
  * @brief This method returns the position in the current line.
  *
  * @return The character index in the line the lexer is scanning
  */
-size_t YAMLLexer::getCharPositionInLine() { return column; }
+template <typename Input>
+size_t YAMLLexer<Input>::getCharPositionInLine() {
+  return currentColumn();
+}
 
 /**
  * @brief This method returns the source the lexer is scanning.
  *
  * @return The input of the lexer
  */
-CharStream *YAMLLexer::getInputStream() { return input; }
+template <typename Input>
+CharStream *YAMLLexer<Input>::getInputStream() { return input; }
 
 /**
  * @brief This method retrieves the name of the source the lexer is currently
@@ -115,7 +432,10 @@ CharStream *YAMLLexer::getInputStream() { return input; }
  *
  * @return The name of the current input source
  */
-std::string YAMLLexer::getSourceName() { return input->getSourceName(); }
+template <typename Input>
+std::string YAMLLexer<Input>::getSourceName() {
+  return input->getSourceName();
+}
 
 /**
  * @brief This setter changes the token factory of the lexer.
@@ -123,8 +443,9 @@ std::string YAMLLexer::getSourceName() { return input->getSourceName(); }
  * @param tokenFactory This parameter specifies the factory that the scanner
  *                     should use to create tokens.
  */
+template <typename Input>
 template <typename T1>
-void YAMLLexer::setTokenFactory(TokenFactory<T1> *tokenFactory) {
+void YAMLLexer<Input>::setTokenFactory(TokenFactory<T1> *tokenFactory) {
   factory = tokenFactory;
 }
 
@@ -133,7 +454,10 @@ void YAMLLexer::setTokenFactory(TokenFactory<T1> *tokenFactory) {
  *
  * @return The factory the scanner uses to create tokens
  */
-Ref<TokenFactory<CommonToken>> YAMLLexer::getTokenFactory() { return factory; }
+template <typename Input>
+Ref<TokenFactory<CommonToken>> YAMLLexer<Input>::getTokenFactory() {
+  return factory;
+}
 
 // ===========
 // = Private =
@@ -151,10 +475,11 @@ Ref<TokenFactory<CommonToken>> YAMLLexer::getTokenFactory() { return factory; }
  *
  * @return A token with the specified parameters
  */
-unique_ptr<CommonToken> YAMLLexer::commonToken(size_t type, size_t start,
-                                               size_t stop) {
-  return factory->create(source, type, "", Token::DEFAULT_CHANNEL, start, stop,
-                         line, column);
+template <typename Input>
+unique_ptr<YAMLToken>
+YAMLLexer<Input>::commonToken(size_t type, size_t start, size_t stop) {
+  return arenaFactory.create(source, type, "", Token::DEFAULT_CHANNEL, start,
+                             stop, 0, 0);
 }
 
 /**
@@ -170,10 +495,12 @@ unique_ptr<CommonToken> YAMLLexer::commonToken(size_t type, size_t start,
  *
  * @return A token with the specified parameters
  */
-unique_ptr<CommonToken> YAMLLexer::commonToken(size_t type, size_t start,
-                                               size_t stop, string text) {
-  return factory->create(source, type, text, Token::DEFAULT_CHANNEL, start,
-                         stop, line, column);
+template <typename Input>
+unique_ptr<YAMLToken> YAMLLexer<Input>::commonToken(size_t type, size_t start,
+                                                    size_t stop,
+                                                    string const &text) {
+  return arenaFactory.create(source, type, text, Token::DEFAULT_CHANNEL,
+                             start, stop, 0, 0);
 }
 
 /**
@@ -186,7 +513,8 @@ unique_ptr<CommonToken> YAMLLexer::commonToken(size_t type, size_t start,
  * @retval true If the function added an indentation value
  *         false Otherwise
  */
-bool YAMLLexer::addIndentation(size_t const lineIndex) {
+template <typename Input>
+bool YAMLLexer<Input>::addIndentation(size_t const lineIndex) {
   if (lineIndex > indents.top()) {
     LOGF("Add indentation {}", lineIndex);
     indents.push(lineIndex);
@@ -198,10 +526,16 @@ bool YAMLLexer::addIndentation(size_t const lineIndex) {
 /**
  * @brief This method adds new tokens to the token stream.
  */
-void YAMLLexer::fetchTokens() {
+template <typename Input>
+void YAMLLexer<Input>::fetchTokens() {
   scanToNextToken();
 
-  addBlockEnd(column);
+  if (isDocumentMarker()) {
+    scanDocumentMarker();
+    return;
+  }
+
+  addBlockEnd(currentColumn());
 
   if (input->LA(1) == Token::EOF) {
     scanEnd();
@@ -226,14 +560,57 @@ void YAMLLexer::fetchTokens() {
   scanPlainScalar();
 }
 
+/**
+ * @brief This method releases the input, the lines and the tokens in front of
+ *        the token the lexer emitted last.
+ *
+ * The lexer emits its tokens in the order of their start index. All tokens
+ * the lexer still needs (including the simple key candidate) are therefore
+ * located behind the token the lexer emitted last. The user of the lexer
+ * might still access this token, but no token in front of it.
+ */
+template <typename Input> void YAMLLexer<Input>::release() {
+  if (!discard(input, emitted.second)) {
+    return;
+  }
+  positions.forget(emitted.second);
+
+  // If the factory created all tokens, the lexer and its user might still
+  // access, after its last rotation, then the other arena only contains
+  // tokens that were already destroyed
+  if (emitted.first >= generation &&
+      tokens.end() - generation >= TOKENS_PER_GENERATION) {
+    LOG("Rotate token arenas");
+    arenaFactory.rotate();
+    generation = tokens.end();
+  }
+}
+
+/**
+ * @brief This method returns the column of the current input position.
+ *
+ * @return The column (starting with `1`) of the current character
+ */
+template <typename Input>
+size_t YAMLLexer<Input>::currentColumn() {
+  size_t const index = input->index();
+  if (columnCache.first < positions.lastLineStart()) {
+    columnCache = make_pair(positions.lastLineStart(), 1);
+  }
+  columnCache.second += positions.countColumns(columnCache.first, index);
+  columnCache.first = index;
+  return columnCache.second;
+}
+
 /**
  * @brief This method consumes characters from the input stream keeping
- *        track of line and column numbers.
+ *        track of the start of each line.
  *
  * @param characters This parameter specifies the number of characters the
  *                   the function should consume.
  */
-void YAMLLexer::forward(size_t const characters = 1) {
+template <typename Input>
+void YAMLLexer<Input>::forward(size_t const characters) {
   LOGF("Forward {} characters", characters);
 
   for (size_t charsLeft = characters; charsLeft > 0; charsLeft--) {
@@ -242,19 +619,68 @@ void YAMLLexer::forward(size_t const characters = 1) {
       return;
     }
 
-    column++;
     if (input->LA(1) == '\n') {
-      column = 1;
-      line++;
+      positions.addLine(input->index() + 1);
     }
     input->consume();
   }
 }
 
+/**
+ * @brief This method consumes characters that are all located in the current
+ *        line.
+ *
+ * Since the characters do not contain a newline, the line index does not
+ * change and the method can skip all characters at once.
+ *
+ * @param characters This parameter specifies the number of characters the
+ *                   function should consume. The characters must not contain
+ *                   a newline character.
+ */
+template <typename Input>
+void YAMLLexer<Input>::forwardInLine(size_t const characters) {
+  LOGF("Forward {} characters", characters);
+  advance(input, characters);
+}
+
+/**
+ * @brief This method counts the characters in front of the next stop
+ *        character.
+ *
+ * If the structural index is available, then the method jumps from one
+ * structural character to the next. Otherwise it searches the input directly.
+ *
+ * @param offset This number specifies the lookahead offset (`1` is the
+ *               current character), where this method starts to search.
+ * @param stops This parameter specifies the characters this method searches
+ *              for. All of them have to be structural characters (see
+ *              `StructuralIndex`).
+ *
+ * @return The number of characters between `offset` and the next stop
+ *         character (or the end of the input)
+ */
+template <typename Input>
+size_t YAMLLexer<Input>::countUntilStop(size_t const offset,
+                                        StopBytes const &stops) {
+  if (!structurals.available()) {
+    return searchStop(input, offset, stops);
+  }
+
+  size_t const index = input->index();
+  size_t const start = min(index + offset - 1, input->size());
+  size_t position = structurals.next(start);
+  while (position < input->size() &&
+         !stops.contains(input->LA(position - index + 1))) {
+    position = structurals.next(position + 1);
+  }
+  return position - start;
+}
+
 /**
  * @brief This method removes uninteresting characters from the input.
  */
-void YAMLLexer::scanToNextToken() {
+template <typename Input>
+void YAMLLexer<Input>::scanToNextToken() {
   LOG("Scan to next token");
   bool found = false;
   while (!found) {
@@ -282,7 +708,8 @@ void YAMLLexer::scanToNextToken() {
  * @retval true If the input matches a key value token
  *         false Otherwise
  */
-bool YAMLLexer::isValue(size_t const offset) const {
+template <typename Input>
+bool YAMLLexer<Input>::isValue(size_t const offset) const {
   return (input->LA(offset) == ':') &&
          (input->LA(offset + 1) == '\n' || input->LA(offset + 1) == ' ');
 }
@@ -293,7 +720,8 @@ bool YAMLLexer::isValue(size_t const offset) const {
  * @retval true If the input matches a list element token
  *         false Otherwise
  */
-bool YAMLLexer::isElement() const {
+template <typename Input>
+bool YAMLLexer<Input>::isElement() const {
   return (input->LA(1) == '-') && (input->LA(2) == '\n' || input->LA(2) == ' ');
 }
 
@@ -307,17 +735,43 @@ bool YAMLLexer::isElement() const {
  * @retval true If the input matches a comment token
  *         false Otherwise
  */
-bool YAMLLexer::isComment(size_t const offset) const {
+template <typename Input>
+bool YAMLLexer<Input>::isComment(size_t const offset) const {
   return (input->LA(offset) == '#') &&
          (input->LA(offset + 1) == '\n' || input->LA(offset + 1) == ' ');
 }
 
+/**
+ * @brief This method checks if the current input starts a document marker.
+ *
+ * @retval true If the input matches a document start marker (`---`) or a
+ *              document end marker (`...`) at the start of a line
+ *         false Otherwise
+ */
+template <typename Input>
+bool YAMLLexer<Input>::isDocumentMarker() {
+  size_t const character = input->LA(1);
+  if ((character != '-' && character != '.') || input->LA(2) != character ||
+      input->LA(3) != character) {
+    return false;
+  }
+  size_t const next = input->LA(4);
+  return (next == ' ' || next == '\n' || next == Token::EOF) &&
+         currentColumn() == 1;
+}
+
 /**
  * @brief This method saves a token for a simple key candidate located at the
  *        current input position.
+ *
+ * The method reserves two slots in the token queue: one for the `MAPPING
+ * START` token, which the lexer needs if the key starts a new mapping, and one
+ * for the `KEY` token itself.
  */
-void YAMLLexer::addSimpleKeyCandidate() {
-  size_t position = tokens.size() + tokensEmitted;
+template <typename Input>
+void YAMLLexer<Input>::addSimpleKeyCandidate() {
+  tokens.reserve(); // `MAPPING START`
+  size_t position = tokens.reserve();
   size_t index = input->index();
   simpleKey = make_pair(commonToken(KEY, index, index, "KEY"), position);
 }
@@ -330,11 +784,12 @@ void YAMLLexer::addSimpleKeyCandidate() {
  *                  of spaces) for which this method should add block end
  *                  tokens.
  */
-void YAMLLexer::addBlockEnd(size_t const lineIndex) {
+template <typename Input>
+void YAMLLexer<Input>::addBlockEnd(size_t const lineIndex) {
   while (lineIndex < indents.top()) {
     LOG("Add block end");
     size_t index = input->index();
-    tokens.push_back(commonToken(BLOCK_END, index, index, "BLOCK END"));
+    tokens.push(commonToken(BLOCK_END, index, index, "BLOCK END"));
     indents.pop();
   }
 }
@@ -343,30 +798,51 @@ void YAMLLexer::addBlockEnd(size_t const lineIndex) {
  * @brief This method adds the token for the start of the YAML stream to
  *        `tokens`.
  */
-void YAMLLexer::scanStart() {
+template <typename Input>
+void YAMLLexer<Input>::scanStart() {
   LOG("Scan start");
   auto start =
       commonToken(STREAM_START, input->index(), input->index(), "START");
-  tokens.push_back(move(start));
+  tokens.push(move(start));
 }
 
 /**
  * @brief This method adds the end markers to the token queue.
  */
-void YAMLLexer::scanEnd() {
+template <typename Input>
+void YAMLLexer<Input>::scanEnd() {
   addBlockEnd(0);
-  tokens.push_back(
+  tokens.push(
       commonToken(STREAM_END, input->index(), input->index(), "END"));
-  tokens.push_back(
+  tokens.push(
       commonToken(Token::EOF, input->index(), input->index(), "EOF"));
   done = true;
 }
 
+/**
+ * @brief This method scans a document marker and adds it to the token queue.
+ *
+ * A document marker closes all block collections of the previous document.
+ * A simple key candidate of the previous document can not continue in the
+ * next document, so the method also removes the candidate.
+ */
+template <typename Input>
+void YAMLLexer<Input>::scanDocumentMarker() {
+  LOG("Scan document marker");
+  simpleKey = make_pair(nullptr, 0);
+  addBlockEnd(0);
+
+  size_t const type = input->LA(1) == '-' ? DOCUMENT_START : DOCUMENT_END;
+  tokens.push(commonToken(type, input->index(), input->index() + 2));
+  forwardInLine(3);
+}
+
 /**
  * @brief This method scans a single quoted scalar and adds it to the token
  *        queue.
  */
-void YAMLLexer::scanSingleQuotedScalar() {
+template <typename Input>
+void YAMLLexer<Input>::scanSingleQuotedScalar() {
   LOG("Scan single quoted scalar");
 
   size_t start = input->index();
@@ -374,11 +850,22 @@ void YAMLLexer::scanSingleQuotedScalar() {
   addSimpleKeyCandidate();
 
   forward(); // Include initial single quote
-  while (input->LA(1) != '\'' || input->LA(2) == '\'') {
-    forward();
+  while (true) {
+    forwardInLine(countUntilStop(1, SINGLE_QUOTED_STOPS));
+    if (input->LA(1) == '\n') {
+      forward();
+    } else if (input->LA(1) == '\'' && input->LA(2) == '\'') {
+      forward(2); // Skip escaped single quote
+    } else {
+      break;
+    }
+  }
+  if (input->LA(1) == Token::EOF) {
+    throw ParseCancellationException(
+        "Unable to locate end of single quoted scalar");
   }
   forward(); // Include closing single quote
-  tokens.push_back(
+  tokens.push(
       commonToken(SINGLE_QUOTED_SCALAR, start, input->index() - 1));
 }
 
@@ -386,7 +873,8 @@ void YAMLLexer::scanSingleQuotedScalar() {
  * @brief This method scans a double quoted scalar and adds it to the token
  *        queue.
  */
-void YAMLLexer::scanDoubleQuotedScalar() {
+template <typename Input>
+void YAMLLexer<Input>::scanDoubleQuotedScalar() {
   LOG("Scan double quoted scalar");
   size_t start = input->index();
 
@@ -394,23 +882,45 @@ void YAMLLexer::scanDoubleQuotedScalar() {
   addSimpleKeyCandidate();
 
   forward(); // Include initial double quote
-  while (input->LA(1) != '"') {
-    forward();
+  while (true) {
+    forwardInLine(countUntilStop(1, DOUBLE_QUOTED_STOPS));
+    if (input->LA(1) == '\n') {
+      forward();
+    } else if (input->LA(1) == '\\') {
+      if (isNullEscape(input)) {
+        throw ParseCancellationException(
+            "Unable to store null character of escape sequence");
+      }
+      forward(2); // Skip escape sequence
+    } else {
+      break;
+    }
+  }
+  if (input->LA(1) == Token::EOF) {
+    throw ParseCancellationException(
+        "Unable to locate end of double quoted scalar");
   }
   forward(); // Include closing double quote
-  tokens.push_back(
+  tokens.push(
       commonToken(DOUBLE_QUOTED_SCALAR, start, input->index() - 1));
 }
 
 /**
  * @brief This method scans a plain scalar and adds it to the token queue.
  */
-void YAMLLexer::scanPlainScalar() {
+template <typename Input>
+void YAMLLexer<Input>::scanPlainScalar() {
   LOG("Scan plain scalar");
   size_t start = input->index();
   // A plain scalar can start a simple key
   addSimpleKeyCandidate();
 
+  if (structurals.available()) {
+    forwardInLine(countPlainScalar());
+    tokens.push(commonToken(PLAIN_SCALAR, start, input->index() - 1));
+    return;
+  }
+
   size_t lengthSpace = 0;
   size_t lengthNonSpace = 0;
   while (true) {
@@ -418,11 +928,41 @@ void YAMLLexer::scanPlainScalar() {
     if (lengthNonSpace == 0) {
       break;
     }
-    forward(lengthSpace + lengthNonSpace);
+    forwardInLine(lengthSpace + lengthNonSpace);
     lengthSpace = countPlainSpace();
   }
 
-  tokens.push_back(commonToken(PLAIN_SCALAR, start, input->index() - 1));
+  tokens.push(commonToken(PLAIN_SCALAR, start, input->index() - 1));
+}
+
+/**
+ * @brief This method uses the structural index to determine the length of the
+ *        plain scalar at the current input position.
+ *
+ * A plain scalar ends in front of the next newline, or the next `:` or `#`
+ * followed by whitespace. All of these characters are structural, so the
+ * method only has to visit the structural characters inside the scalar.
+ *
+ * @return The number of characters of the plain scalar (excluding trailing
+ *         spaces)
+ */
+template <typename Input>
+size_t YAMLLexer<Input>::countPlainScalar() {
+  LOG("Scan plain scalar using structural index");
+  size_t const start = input->index();
+  size_t end = structurals.next(start);
+  while (end < input->size()) {
+    size_t const character = input->LA(end - start + 1);
+    if (character == '\n' || character == ':' || character == '#') {
+      break;
+    }
+    end = structurals.next(end + 1);
+  }
+  end = min(end, input->size());
+  while (end > start && input->LA(end - start) == ' ') {
+    end--;
+  }
+  return end - start;
 }
 
 /**
@@ -435,15 +975,19 @@ void YAMLLexer::scanPlainScalar() {
  *
  * @return The number of non-space characters at the input position `offset`
  */
-size_t YAMLLexer::countPlainNonSpace(size_t const offset) const {
+template <typename Input>
+size_t YAMLLexer<Input>::countPlainNonSpace(size_t const offset) const {
   LOG("Scan non space characters");
-  string const stop = " \n";
 
   size_t lookahead = offset + 1;
-  while (stop.find(input->LA(lookahead)) == string::npos &&
-         input->LA(lookahead) != Token::EOF && !isValue(lookahead) &&
-         !isComment(lookahead)) {
-    lookahead++;
+  while (true) {
+    lookahead += searchStop(input, lookahead, PLAIN_STOPS);
+    size_t const character = input->LA(lookahead);
+    if (character == ' ' || character == '\n' || character == Token::EOF ||
+        isValue(lookahead) || isComment(lookahead)) {
+      break;
+    }
+    lookahead++; // Skip `:` or `#` inside the scalar
   }
 
   LOGF("Found {} non-space characters", lookahead - offset - 1);
@@ -456,7 +1000,8 @@ size_t YAMLLexer::countPlainNonSpace(size_t const offset) const {
  *
  * @return The number of space characters at the current input position
  */
-size_t YAMLLexer::countPlainSpace() const {
+template <typename Input>
+size_t YAMLLexer<Input>::countPlainSpace() const {
   LOG("Scan spaces");
   size_t lookahead = 1;
   while (input->LA(lookahead) == ' ') {
@@ -469,33 +1014,33 @@ size_t YAMLLexer::countPlainSpace() const {
 /**
  * @brief This method scans a comment and adds it to the token queue.
  */
-void YAMLLexer::scanComment() {
+template <typename Input>
+void YAMLLexer<Input>::scanComment() {
   LOG("Scan comment");
   size_t start = input->index();
 
-  while (input->LA(1) != '\n') {
-    forward();
-  }
-  tokens.push_back(commonToken(COMMENT, start, input->index() - 1));
+  forwardInLine(countUntilStop(1, COMMENT_STOPS));
+  tokens.push(commonToken(COMMENT, start, input->index() - 1));
 }
 
 /**
  * @brief This method scans a mapping value token and adds it to the token
  *        queue.
  */
-void YAMLLexer::scanValue() {
+template <typename Input>
+void YAMLLexer<Input>::scanValue() {
   LOG("Scan value");
-  tokens.push_back(commonToken(VALUE, input->index(), input->index() + 1));
+  tokens.push(commonToken(VALUE, input->index(), input->index() + 1));
   forward(2);
   if (simpleKey.first == nullptr) {
     throw ParseCancellationException("Unable to locate key for value");
   }
   size_t start = simpleKey.first->getCharPositionInLine();
-  tokens.insert(tokens.begin() + simpleKey.second - tokensEmitted,
-                move(simpleKey.first));
+  size_t index = simpleKey.first->getStartIndex();
+  tokens.fill(simpleKey.second, move(simpleKey.first));
   if (addIndentation(start)) {
-    tokens.push_front(
-        commonToken(MAPPING_START, start, column, "MAPPING START"));
+    tokens.fill(simpleKey.second - 1,
+                commonToken(MAPPING_START, index, index, "MAPPING START"));
   }
 }
 
@@ -503,12 +1048,19 @@ void YAMLLexer::scanValue() {
  * @brief This method scans a list element token and adds it to the token
  *        queue.
  */
-void YAMLLexer::scanElement() {
+template <typename Input>
+void YAMLLexer<Input>::scanElement() {
   LOG("Scan element");
-  if (addIndentation(column)) {
-    tokens.push_back(
-        commonToken(SEQUENCE_START, input->index(), column, "SEQUENCE START"));
+  if (addIndentation(currentColumn())) {
+    tokens.push(commonToken(SEQUENCE_START, input->index(), input->index(),
+                            "SEQUENCE START"));
   }
-  tokens.push_back(commonToken(ELEMENT, input->index(), input->index() + 1));
+  tokens.push(commonToken(ELEMENT, input->index(), input->index() + 1));
   forward(2);
 }
+
+// -- Instantiations -----------------------------------------------------------
+
+template class YAMLLexer<CharStream>;
+template class YAMLLexer<BufferStream>;
+template class YAMLLexer<ChunkStream>;
@@ -15,10 +15,38 @@
 
 // -- Macros -------------------------------------------------------------------
 
-#define SPDLOG_TRACE_ON
+// The build system sets `SPDLOG_ACTIVE_LEVEL` according to the CMake option
+// `LOG_LEVEL`. If the active level is higher than `trace`, then the logging
+// macros below expand to an empty statement and the compiler removes all
+// trace calls (including the evaluation of their arguments) from the lexer.
+// Both variants expand to a `do … while (0)` statement, so each call needs a
+// semicolon and behaves like a single statement, even in an unbraced `if`.
+#ifndef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_OFF
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define HAVE_TRACE
 #define LOGF(fmt, ...)                                                         \
-  console->trace("{}:{}: " fmt, __FUNCTION__, __LINE__, __VA_ARGS__);
-#define LOG(text) console->trace("{}:{}: {}", __FUNCTION__, __LINE__, text);
+  do {                                                                         \
+    if (console->should_log(spdlog::level::trace)) {                           \
+      console->trace("{}:{}: " fmt, __FUNCTION__, __LINE__, __VA_ARGS__);      \
+    }                                                                          \
+  } while (0)
+#define LOG(text)                                                              \
+  do {                                                                         \
+    if (console->should_log(spdlog::level::trace)) {                           \
+      console->trace("{}:{}: {}", __FUNCTION__, __LINE__, text);               \
+    }                                                                          \
+  } while (0)
+#else
+#define LOGF(fmt, ...)                                                         \
+  do {                                                                         \
+  } while (0)
+#define LOG(text)                                                              \
+  do {                                                                         \
+  } while (0)
+#endif
 
 // -- Imports ------------------------------------------------------------------
 
@@ -26,6 +54,14 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include "BufferStream.hpp"
+#include "ChunkStream.hpp"
+#include "LineIndex.hpp"
+#include "ScanKernels.hpp"
+#include "StructuralIndex.hpp"
+#include "TokenQueue.hpp"
+#include "YAMLToken.hpp"
+
 using std::deque;
 using std::pair;
 using std::shared_ptr;
@@ -42,39 +78,103 @@ using antlr4::TokenSource;
 
 using spdlog::logger;
 
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a logger that prints the trace messages of a
+ *        lexer to the standard error output.
+ *
+ * The function does not add the logger to the registry of `spdlog`. A program
+ * can therefore create as many of these loggers as it needs.
+ *
+ * @return A new logger for trace messages
+ */
+shared_ptr<logger> createTraceLogger();
+
 // -- Class --------------------------------------------------------------------
 
-class YAMLLexer : public TokenSource {
+/**
+ * @brief This class scans YAML data and produces the tokens used by the parser
+ *        specified in `YAML.g4`.
+ *
+ * The lexer reads the input through the class specified via the template
+ * parameter `Input`. The generic version (`YAMLLexer<CharStream>`) accepts
+ * every ANTLR character stream and calls the virtual method `LA` for each
+ * lookahead character. The version for `BufferStream` scans a contiguous
+ * buffer in memory: Since `BufferStream` is a final class, that defines its
+ * character access methods inline, the compiler replaces these calls with
+ * direct pointer accesses.
+ *
+ * The version for `ChunkStream` reads its input through a sliding window.
+ * Before it scans the next token, the lexer releases the part of the input,
+ * the lines and the tokens in front of the token it emitted last. The memory
+ * usage of this version therefore does not grow with the size of the input.
+ * In return, the user of the lexer has to destroy each token, before it
+ * requests the next token but one, like `EventParser` does. A token stream
+ * that keeps all tokens, such as `CommonTokenStream`, must not read the
+ * tokens of this version.
+ *
+ * @tparam Input This type specifies the character stream the lexer scans.
+ */
+template <typename Input = CharStream> class YAMLLexer : public TokenSource {
   /** This variable stores the input that this lexer scans. */
-  CharStream *input;
+  Input *input;
 
-  /** This queue stores the list of tokens produced by the lexer. */
-  deque<unique_ptr<CommonToken>> tokens;
+  /**
+   * This index stores the position of each structural character of the
+   * input. The index is only available, if the lexer scans a `BufferStream`.
+   */
+  StructuralIndex structurals;
 
-  /** The lexer uses this factory to produce tokens. */
-  Ref<TokenFactory<CommonToken>> factory = CommonTokenFactory::DEFAULT;
+  /**
+   * This index stores the start of every line the lexer scanned so far. The
+   * lexer and its tokens use the index to compute line and column numbers,
+   * only if they need them.
+   */
+  LineIndex positions;
 
-  /** This pair stores the token source (this lexer) and the current `input`. */
-  pair<TokenSource *, CharStream *> source;
+  /**
+   * The lexer uses this factory to produce tokens. The factory stores all
+   * tokens in its arenas, which it frees when the lexer is destroyed. Tokens
+   * produced by the lexer are therefore only valid as long as the lexer
+   * exists.
+   */
+  YAMLTokenFactory arenaFactory{&positions};
+
+  /**
+   * This number stores the position in `tokens` of the first token the
+   * factory created after its last rotation.
+   */
+  size_t generation = 0;
 
   /**
-   * This variable saves the current line position of the lexer inside
-   * `input`.
+   * This pair stores the position in `tokens` (first part) and the start
+   * index (second part) of the token the lexer emitted last.
    */
-  size_t line = 1;
+  pair<size_t, size_t> emitted{0, 0};
 
   /**
-   * This number stores the current character position of the lexer inside of
-   * `line`.
+   * This queue stores the list of tokens produced by the lexer, that the
+   * lexer did not emit yet.
    */
-  size_t column = 1;
+  TokenQueue tokens;
+
+  /**
+   * The parser uses this factory to create tokens for missing input during
+   * error recovery.
+   */
+  Ref<TokenFactory<CommonToken>> factory = CommonTokenFactory::DEFAULT;
+
+  /** This pair stores the token source (this lexer) and the current `input`. */
+  pair<TokenSource *, CharStream *> source;
 
   /**
-   * This counter stores the number of tokens already emitted by the lexer.
-   * The lexer needs this variable, to keep track of the insertion point of
-   * `KEY` tokens in the token queue.
+   * This pair caches the column (second part) of a position (first part) in
+   * the current line. This way the lexer only has to count the characters
+   * between this position and the current position, to determine the current
+   * column.
    */
-  size_t tokensEmitted = 0;
+  pair<size_t, size_t> columnCache{0, 1};
 
   /**
    * This stack stores the indentation (in number of characters) for each
@@ -89,17 +189,21 @@ class YAMLLexer : public TokenSource {
   bool done = false;
 
   /**
-   * This pair stores a simple key candidate token (first part) and its
-   * position in the token queue (second part).
+   * This pair stores a simple key candidate token (first part) and the
+   * position of the slot reserved for it in the token queue (second part).
+   * The slot directly in front of this position is reserved for a
+   * `MAPPING START` token.
    *
    * Since the lexer only supports block syntax for mappings and sequences we
    * use a single token here. If we need support for flow collections we have
    * to store a candidate for each flow level (block context = flow level 0).
    */
-  pair<unique_ptr<CommonToken>, size_t> simpleKey;
+  pair<unique_ptr<YAMLToken>, size_t> simpleKey;
 
   /**
    * This variable stores the logger used by the lexer to print debug messages.
+   * Lexers without a logger of their own share a logger that discards all
+   * messages.
    */
   shared_ptr<logger> console;
 
@@ -116,8 +220,8 @@ class YAMLLexer : public TokenSource {
    *
    * @return A token with the specified parameters
    */
-  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop,
-                                      string text);
+  unique_ptr<YAMLToken> commonToken(size_t type, size_t start, size_t stop,
+                                    string const &text);
 
   /**
    * @brief This function creates a new token with the specified parameters.
@@ -131,7 +235,7 @@ class YAMLLexer : public TokenSource {
    *
    * @return A token with the specified parameters
    */
-  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop);
+  unique_ptr<YAMLToken> commonToken(size_t type, size_t start, size_t stop);
 
   /**
    * @brief This function adds an indentation value if the given value is
@@ -158,14 +262,54 @@ class YAMLLexer : public TokenSource {
    */
   void fetchTokens();
 
+  /**
+   * @brief This method releases the input, the lines and the tokens in front
+   *        of the token the lexer emitted last.
+   *
+   * The method only releases memory, if the lexer scans a `ChunkStream`.
+   */
+  void release();
+
+  /**
+   * @brief This method returns the column of the current input position.
+   *
+   * @return The column (starting with `1`) of the current character
+   */
+  size_t currentColumn();
+
   /**
    * @brief This method consumes characters from the input stream keeping
-   *        track of line and column numbers.
+   *        track of the start of each line.
    *
    * @param characters This parameter specifies the number of characters the
    *                   the function should consume.
    */
-  void forward(size_t const characters);
+  void forward(size_t const characters = 1);
+
+  /**
+   * @brief This method consumes characters that are all located in the
+   *        current line.
+   *
+   * @param characters This parameter specifies the number of characters the
+   *                   function should consume. The characters must not
+   *                   contain a newline character.
+   */
+  void forwardInLine(size_t const characters);
+
+  /**
+   * @brief This method counts the characters in front of the next stop
+   *        character.
+   *
+   * @param offset This number specifies the lookahead offset (`1` is the
+   *               current character), where this method starts to search.
+   * @param stops This parameter specifies the characters this method
+   *              searches for. All of them have to be structural characters
+   *              (see `StructuralIndex`).
+   *
+   * @return The number of characters between `offset` and the next stop
+   *         character (or the end of the input)
+   */
+  size_t countUntilStop(size_t const offset, StopBytes const &stops);
 
   /**
    * @brief This method removes uninteresting characters from the input.
@@ -204,6 +348,15 @@ class YAMLLexer : public TokenSource {
    */
   bool isComment(size_t const offset) const;
 
+  /**
+   * @brief This method checks if the current input starts a document marker.
+   *
+   * @retval true If the input matches a document start marker (`---`) or a
+   *              document end marker (`...`) at the start of a line
+   *         false Otherwise
+   */
+  bool isDocumentMarker();
+
   /**
    * @brief This method saves a token for a simple key candidate located at the
    *        current input position.
@@ -231,6 +384,11 @@ class YAMLLexer : public TokenSource {
    */
   void scanEnd();
 
+  /**
+   * @brief This method scans a document marker and adds it to the token queue.
+   */
+  void scanDocumentMarker();
+
   /**
    * @brief This method scans a single quoted scalar and adds it to the token
    *        queue.
@@ -242,6 +400,15 @@ class YAMLLexer : public TokenSource {
    */
   void scanPlainScalar();
 
+  /**
+   * @brief This method uses the structural index to determine the length of
+   *        the plain scalar at the current input position.
+   *
+   * @return The number of characters of the plain scalar (excluding trailing
+   *         spaces)
+   */
+  size_t countPlainScalar();
+
   /**
    * @brief This method counts the number of non space characters that can be
    *        part of a plain scalar at position `offset`.
@@ -310,13 +477,31 @@ public:
   static const size_t COMMENT = 11;
   /** This token type specifies that the token stores a single quoted scalar. */
   static const size_t SINGLE_QUOTED_SCALAR = 12;
+  /** This token type indicates the start of a document (`---`). */
+  static const size_t DOCUMENT_START = 13;
+  /** This token type indicates the end of a document (`...`). */
+  static const size_t DOCUMENT_END = 14;
 
   /**
    * @brief This constructor creates a new YAML lexer for the given input.
    *
    * @param input This character stream stores the data this lexer scans.
+   * @param output This parameter stores the logger that receives the trace
+   *               messages of the lexer. If this parameter is `nullptr`, then
+   *               the lexer does not print any messages.
    */
-  YAMLLexer(CharStream *input);
+  YAMLLexer(Input *input, shared_ptr<logger> output = nullptr);
+
+  /**
+   * @brief This method prepares the lexer to scan a new input.
+   *
+   * The lexer releases the memory of all tokens it created for the last
+   * input. Call this method only after all of these tokens were destroyed
+   * (for example by `BufferedTokenStream::setTokenSource`).
+   *
+   * @param stream This character stream stores the data this lexer scans.
+   */
+  void reset(Input *stream);
 
   /**
    * @brief This method retrieves the current (not already emitted) token
@@ -333,6 +518,17 @@ public:
    */
   size_t getLine() const override;
 
+  /**
+   * @brief This method returns the line index of the lexer.
+   *
+   * The index contains all lines the lexer scanned so far, except for the
+   * lines a lexer for a `ChunkStream` already released. It stays valid as
+   * long as the lexer exists.
+   *
+   * @return An index that maps input positions to line and column numbers
+   */
+  LineIndex const &getLineIndex() const;
+
   /**
    * @brief This method returns the position in the current line.
    *
@@ -370,3 +566,7 @@ public:
    */
   Ref<TokenFactory<CommonToken>> getTokenFactory() override;
 };
+
+extern template class YAMLLexer<CharStream>;
+extern template class YAMLLexer<BufferStream>;
+extern template class YAMLLexer<ChunkStream>;
@@ -0,0 +1,343 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "YAMLToken.hpp"
+
+using std::to_string;
+
+using antlr4::misc::Interval;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function replaces control characters with escape sequences.
+ *
+ * @param text This parameter stores the text this function escapes.
+ *
+ * @return A copy of `text`, where newline, carriage return and tab characters
+ *         are replaced by escape sequences
+ */
+string escape(string const &text) {
+  string escaped;
+  escaped.reserve(text.size());
+  for (char character : text) {
+    switch (character) {
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\r':
+      escaped += "\\r";
+      break;
+    case '\t':
+      escaped += "\\t";
+      break;
+    default:
+      escaped += character;
+    }
+  }
+  return escaped;
+}
+
+/**
+ * @brief This function converts a token attribute to a signed number.
+ *
+ * This way we print `EOF` and invalid indices as `-1`, like `CommonToken`.
+ *
+ * @param value This parameter stores the value this function converts.
+ *
+ * @return A string containing the signed representation of `value`
+ */
+string numeric(size_t const value) {
+  return to_string(static_cast<ssize_t>(value));
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new token.
+ *
+ * @param origin This parameter stores the lexer and input of the token.
+ * @param storage This parameter specifies the arena that contains the token.
+ * @param lineIndex This parameter specifies the index the token uses to
+ *                  compute its position. If this value is `nullptr`, then the
+ *                  token uses `lineNumber` and `columnNumber` instead.
+ * @param tokenType This number specifies the type of the token.
+ * @param tokenText This parameter stores a text that replaces the text of the
+ *                  input (or `nullptr`).
+ * @param tokenChannel This number specifies the channel of the token.
+ * @param startIndex This number specifies the start index of the token.
+ * @param stopIndex This number specifies the stop index of the token.
+ * @param lineNumber This number specifies the line of the token.
+ * @param columnNumber This number specifies the column of the token.
+ */
+YAMLToken::YAMLToken(pair<TokenSource *, CharStream *> const &origin,
+                     Arena &storage, LineIndex const *lineIndex,
+                     size_t const tokenType, char const *tokenText,
+                     size_t const tokenChannel, size_t const startIndex,
+                     size_t const stopIndex, size_t const lineNumber,
+                     size_t const columnNumber)
+    : source{origin.first}, input{origin.second}, arena{&storage},
+      positions{lineIndex}, text{tokenText}, type{tokenType},
+      start{startIndex}, stop{stopIndex}, index{INVALID_INDEX},
+      line{static_cast<uint32_t>(lineNumber)},
+      column{static_cast<uint32_t>(columnNumber)},
+      channel{static_cast<uint32_t>(tokenChannel)} {}
+
+/**
+ * @brief This function allocates memory for a token inside an arena.
+ *
+ * @param size This number specifies the size of the token in bytes.
+ * @param arena This parameter specifies the arena that stores the token.
+ *
+ * @return A pointer to memory for a new token
+ */
+void *YAMLToken::operator new(size_t const size, Arena &arena) {
+  return arena.allocate(size, alignof(YAMLToken));
+}
+
+/**
+ * @brief This function would free the memory of a token.
+ *
+ * The arena that contains the token owns this memory, so this function does
+ * nothing.
+ *
+ * @param memory This parameter stores the location of the token.
+ */
+void YAMLToken::operator delete(void *memory __attribute__((unused))) {}
+
+/**
+ * @brief This function frees the memory of a token, if its constructor fails.
+ *
+ * @param memory This parameter stores the location of the token.
+ * @param arena This parameter specifies the arena that stores the token.
+ */
+void YAMLToken::operator delete(void *memory __attribute__((unused)),
+                                Arena &arena __attribute__((unused))) {}
+
+/**
+ * @brief This method returns the text of the token.
+ *
+ * @return The explicit text of the token, or the part of the input the token
+ *         represents
+ */
+string YAMLToken::getText() const {
+  if (text != nullptr) {
+    return text;
+  }
+  if (input == nullptr) {
+    return "";
+  }
+  size_t const size = input->size();
+  if (start < size && stop < size) {
+    return input->getText(Interval(start, stop));
+  }
+  return "<EOF>";
+}
+
+/**
+ * @brief This method returns the type of the token.
+ *
+ * @return The type of the token
+ */
+size_t YAMLToken::getType() const { return type; }
+
+/**
+ * @brief This method returns the line of the token.
+ *
+ * @return The line number of the token
+ */
+size_t YAMLToken::getLine() const {
+  return positions == nullptr ? line : positions->line(start);
+}
+
+/**
+ * @brief This method returns the position of the token in its line.
+ *
+ * @return The column of the token
+ */
+size_t YAMLToken::getCharPositionInLine() const {
+  return positions == nullptr ? column : positions->column(start);
+}
+
+/**
+ * @brief This method returns the channel of the token.
+ *
+ * @return The channel of the token
+ */
+size_t YAMLToken::getChannel() const { return channel; }
+
+/**
+ * @brief This method returns the position of the token in the token stream.
+ *
+ * @return The index of the token
+ */
+size_t YAMLToken::getTokenIndex() const { return index; }
+
+/**
+ * @brief This method returns the index of the first character of the token.
+ *
+ * @return The start index of the token inside the input
+ */
+size_t YAMLToken::getStartIndex() const { return start; }
+
+/**
+ * @brief This method returns the index of the last character of the token.
+ *
+ * @return The stop index of the token inside the input
+ */
+size_t YAMLToken::getStopIndex() const { return stop; }
+
+/**
+ * @brief This method returns the lexer that produced the token.
+ *
+ * @return The source of the token
+ */
+TokenSource *YAMLToken::getTokenSource() const { return source; }
+
+/**
+ * @brief This method returns the input the token was created from.
+ *
+ * @return The input stream of the token
+ */
+CharStream *YAMLToken::getInputStream() const { return input; }
+
+/**
+ * @brief This method returns a textual representation of the token.
+ *
+ * @return A string using the same format as `CommonToken::toString`
+ */
+string YAMLToken::toString() const {
+  string content = getText();
+  content = content.empty() ? "<no text>" : escape(content);
+  return "[@" + numeric(index) + "," + numeric(start) + ":" + numeric(stop) +
+         "='" + content + "',<" + numeric(type) + ">" +
+         (channel > 0 ? ",channel=" + to_string(channel) : "") + "," +
+         to_string(getLine()) + ":" + to_string(getCharPositionInLine()) + "]";
+}
+
+/**
+ * @brief This method replaces the text of the token.
+ *
+ * @param newText This parameter specifies the new text of the token.
+ */
+void YAMLToken::setText(string const &newText) { text = arena->copy(newText); }
+
+/**
+ * @brief This method changes the type of the token.
+ *
+ * @param newType This number specifies the new type of the token.
+ */
+void YAMLToken::setType(size_t newType) { type = newType; }
+
+/**
+ * @brief This method changes the line of the token.
+ *
+ * @param newLine This number specifies the new line of the token.
+ */
+void YAMLToken::setLine(size_t newLine) {
+  column = static_cast<uint32_t>(getCharPositionInLine());
+  positions = nullptr;
+  line = static_cast<uint32_t>(newLine);
+}
+
+/**
+ * @brief This method changes the position of the token in its line.
+ *
+ * @param newColumn This number specifies the new column of the token.
+ */
+void YAMLToken::setCharPositionInLine(size_t newColumn) {
+  line = static_cast<uint32_t>(getLine());
+  positions = nullptr;
+  column = static_cast<uint32_t>(newColumn);
+}
+
+/**
+ * @brief This method changes the channel of the token.
+ *
+ * @param newChannel This number specifies the new channel of the token.
+ */
+void YAMLToken::setChannel(size_t newChannel) {
+  channel = static_cast<uint32_t>(newChannel);
+}
+
+/**
+ * @brief This method changes the position of the token in the token stream.
+ *
+ * @param newIndex This number specifies the new index of the token.
+ */
+void YAMLToken::setTokenIndex(size_t newIndex) { index = newIndex; }
+
+// -- Factory ------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new token factory.
+ *
+ * @param lineIndex This parameter specifies the line index of the input.
+ *                  Tokens created with line number `0` compute their position
+ *                  from their start index using this index.
+ */
+YAMLTokenFactory::YAMLTokenFactory(LineIndex const *lineIndex)
+    : positions{lineIndex} {}
+
+/**
+ * @brief This method creates a new token.
+ *
+ * @param source This parameter stores the lexer and input of the token.
+ * @param type This number specifies the type of the token.
+ * @param text This parameter stores the text of the token. If the text is
+ *             empty, then the token retrieves its text from the input.
+ * @param channel This number specifies the channel of the token.
+ * @param start This number specifies the start index of the token.
+ * @param stop This number specifies the stop index of the token.
+ * @param line This number specifies the line of the token. The value `0`
+ *             means that the token computes its position lazily.
+ * @param charPositionInLine This number specifies the column of the token.
+ *
+ * @return A token with the specified parameters
+ */
+unique_ptr<YAMLToken> YAMLTokenFactory::create(
+    pair<TokenSource *, CharStream *> source, size_t type, string const &text,
+    size_t channel, size_t start, size_t stop, size_t line,
+    size_t charPositionInLine) {
+  char const *content = text.empty() ? nullptr : arena->copy(text);
+  LineIndex const *lineIndex =
+      line == 0 && start != INVALID_INDEX ? positions : nullptr;
+  return unique_ptr<YAMLToken>{new (*arena) YAMLToken{
+      source, *arena, lineIndex, type, content, channel, start, stop, line,
+      charPositionInLine}};
+}
+
+/**
+ * @brief This method creates a new token that does not belong to any input.
+ *
+ * @param type This number specifies the type of the token.
+ * @param text This parameter stores the text of the token.
+ *
+ * @return A token with the specified parameters
+ */
+unique_ptr<YAMLToken> YAMLTokenFactory::create(size_t type,
+                                               string const &text) {
+  return create({nullptr, nullptr}, type, text, Token::DEFAULT_CHANNEL,
+                INVALID_INDEX, INVALID_INDEX, 0, 0);
+}
+
+/**
+ * @brief This method releases the memory of all tokens created by the factory.
+ */
+void YAMLTokenFactory::reset() {
+  arenas[0].reset();
+  arenas[1].reset();
+  arena = &arenas[0];
+}
+
+/**
+ * @brief This method releases the memory of the tokens stored in the other
+ *        arena and then creates all new tokens in this arena.
+ */
+void YAMLTokenFactory::rotate() {
+  arena = arena == &arenas[0] ? &arenas[1] : &arenas[0];
+  arena->reset();
+}
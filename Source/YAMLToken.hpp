@@ -0,0 +1,341 @@
+#ifndef YAML_TOKEN_HPP
+#define YAML_TOKEN_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+
+#include "Arena.hpp"
+#include "LineIndex.hpp"
+
+using std::pair;
+using std::string;
+using std::uint32_t;
+using std::unique_ptr;
+
+using antlr4::CharStream;
+using antlr4::Token;
+using antlr4::TokenFactory;
+using antlr4::TokenSource;
+using antlr4::WritableToken;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores a token produced by the YAML lexer.
+ *
+ * Compared to `CommonToken` this class only stores the type and the start and
+ * stop index of the token. The token computes its text from the input, when
+ * someone requests it. Only tokens that do not represent a part of the input
+ * (such as `KEY` or `BLOCK_END`) store a text. This text is located in the
+ * same arena as the token.
+ *
+ * Tokens created by the lexer also do not store their line and column. They
+ * look up the position of their start index in the line index of the lexer
+ * instead.
+ *
+ * Tokens of this class can only be created in an `Arena`. Deleting a token
+ * calls its destructor, but does not free its memory: The arena releases the
+ * memory of all tokens at once.
+ */
+class YAMLToken final : public WritableToken {
+  /** This variable stores the lexer that produced the token. */
+  TokenSource *source;
+
+  /** This variable stores the input the lexer produced the token from. */
+  CharStream *input;
+
+  /** This variable stores the arena that contains the token. */
+  Arena *arena;
+
+  /**
+   * This variable stores the index the token uses to compute its line and
+   * column, or `nullptr` if the token stores its position explicitly.
+   */
+  LineIndex const *positions;
+
+  /** This variable stores the explicit text of the token or `nullptr`. */
+  char const *text;
+
+  /** This variable stores the type of the token. */
+  size_t type;
+
+  /** This variable stores the index of the first character of the token. */
+  size_t start;
+
+  /** This variable stores the index of the last character of the token. */
+  size_t stop;
+
+  /** This variable stores the position of the token in the token stream. */
+  size_t index;
+
+  /** This variable stores the explicit line number of the token. */
+  uint32_t line;
+
+  /** This variable stores the explicit column of the token in `line`. */
+  uint32_t column;
+
+  /** This variable stores the channel of the token. */
+  uint32_t channel;
+
+public:
+  /**
+   * @brief This constructor creates a new token.
+   *
+   * @param origin This parameter stores the lexer and input of the token.
+   * @param storage This parameter specifies the arena that contains the
+   *                token.
+   * @param lineIndex This parameter specifies the index the token uses to
+   *                  compute its position. If this value is `nullptr`, then
+   *                  the token uses `lineNumber` and `columnNumber` instead.
+   * @param tokenType This number specifies the type of the token.
+   * @param tokenText This parameter stores a text that replaces the text of
+   *                  the input (or `nullptr`).
+   * @param tokenChannel This number specifies the channel of the token.
+   * @param startIndex This number specifies the start index of the token.
+   * @param stopIndex This number specifies the stop index of the token.
+   * @param lineNumber This number specifies the line of the token.
+   * @param columnNumber This number specifies the column of the token.
+   */
+  YAMLToken(pair<TokenSource *, CharStream *> const &origin, Arena &storage,
+            LineIndex const *lineIndex, size_t const tokenType,
+            char const *tokenText,
+            size_t const tokenChannel, size_t const startIndex,
+            size_t const stopIndex, size_t const lineNumber,
+            size_t const columnNumber);
+
+  /**
+   * @brief This function allocates memory for a token inside an arena.
+   *
+   * @param size This number specifies the size of the token in bytes.
+   * @param arena This parameter specifies the arena that stores the token.
+   *
+   * @return A pointer to memory for a new token
+   */
+  static void *operator new(size_t const size, Arena &arena);
+
+  /**
+   * @brief This function would free the memory of a token.
+   *
+   * The arena that contains the token owns this memory, so this function
+   * does nothing.
+   *
+   * @param memory This parameter stores the location of the token.
+   */
+  static void operator delete(void *memory);
+
+  /**
+   * @brief This function frees the memory of a token, if its constructor
+   *        fails.
+   *
+   * @param memory This parameter stores the location of the token.
+   * @param arena This parameter specifies the arena that stores the token.
+   */
+  static void operator delete(void *memory, Arena &arena);
+
+  /**
+   * @brief This method returns the text of the token.
+   *
+   * @return The explicit text of the token, or the part of the input the
+   *         token represents
+   */
+  string getText() const override;
+
+  /**
+   * @brief This method returns the type of the token.
+   *
+   * @return The type of the token
+   */
+  size_t getType() const override;
+
+  /**
+   * @brief This method returns the line of the token.
+   *
+   * @return The line number of the token
+   */
+  size_t getLine() const override;
+
+  /**
+   * @brief This method returns the position of the token in its line.
+   *
+   * @return The column of the token
+   */
+  size_t getCharPositionInLine() const override;
+
+  /**
+   * @brief This method returns the channel of the token.
+   *
+   * @return The channel of the token
+   */
+  size_t getChannel() const override;
+
+  /**
+   * @brief This method returns the position of the token in the token
+   *        stream.
+   *
+   * @return The index of the token
+   */
+  size_t getTokenIndex() const override;
+
+  /**
+   * @brief This method returns the index of the first character of the token.
+   *
+   * @return The start index of the token inside the input
+   */
+  size_t getStartIndex() const override;
+
+  /**
+   * @brief This method returns the index of the last character of the token.
+   *
+   * @return The stop index of the token inside the input
+   */
+  size_t getStopIndex() const override;
+
+  /**
+   * @brief This method returns the lexer that produced the token.
+   *
+   * @return The source of the token
+   */
+  TokenSource *getTokenSource() const override;
+
+  /**
+   * @brief This method returns the input the token was created from.
+   *
+   * @return The input stream of the token
+   */
+  CharStream *getInputStream() const override;
+
+  /**
+   * @brief This method returns a textual representation of the token.
+   *
+   * @return A string using the same format as `CommonToken::toString`
+   */
+  string toString() const override;
+
+  /**
+   * @brief This method replaces the text of the token.
+   *
+   * @param newText This parameter specifies the new text of the token.
+   */
+  void setText(string const &newText) override;
+
+  /**
+   * @brief This method changes the type of the token.
+   *
+   * @param newType This number specifies the new type of the token.
+   */
+  void setType(size_t newType) override;
+
+  /**
+   * @brief This method changes the line of the token.
+   *
+   * @param newLine This number specifies the new line of the token.
+   */
+  void setLine(size_t newLine) override;
+
+  /**
+   * @brief This method changes the position of the token in its line.
+   *
+   * @param newColumn This number specifies the new column of the token.
+   */
+  void setCharPositionInLine(size_t newColumn) override;
+
+  /**
+   * @brief This method changes the channel of the token.
+   *
+   * @param newChannel This number specifies the new channel of the token.
+   */
+  void setChannel(size_t newChannel) override;
+
+  /**
+   * @brief This method changes the position of the token in the token stream.
+   *
+   * @param newIndex This number specifies the new index of the token.
+   */
+  void setTokenIndex(size_t newIndex) override;
+};
+
+/**
+ * @brief This class creates tokens inside an arena.
+ *
+ * The factory owns the arena. All tokens created by the factory become
+ * invalid, as soon as the factory is destroyed.
+ *
+ * A lexer, whose user only keeps the last few tokens, does not have to keep
+ * the memory of all tokens until the end of the input. The factory therefore
+ * uses two arenas: After `rotate`, the factory creates new tokens in the
+ * other arena, whose old tokens it releases at once.
+ */
+class YAMLTokenFactory : public TokenFactory<YAMLToken> {
+  /** These variables store the memory of all tokens created by the factory. */
+  Arena arenas[2];
+
+  /** This variable stores the arena that receives new tokens. */
+  Arena *arena = &arenas[0];
+
+  /**
+   * This variable stores the line index used by tokens that do not store
+   * their position explicitly.
+   */
+  LineIndex const *positions;
+
+public:
+  /**
+   * @brief This constructor creates a new token factory.
+   *
+   * @param lineIndex This parameter specifies the line index of the input.
+   *                  Tokens created with line number `0` compute their
+   *                  position from their start index using this index.
+   */
+  YAMLTokenFactory(LineIndex const *lineIndex = nullptr);
+
+  /**
+   * @brief This method creates a new token.
+   *
+   * @param source This parameter stores the lexer and input of the token.
+   * @param type This number specifies the type of the token.
+   * @param text This parameter stores the text of the token. If the text is
+   *             empty, then the token retrieves its text from the input.
+   * @param channel This number specifies the channel of the token.
+   * @param start This number specifies the start index of the token.
+   * @param stop This number specifies the stop index of the token.
+   * @param line This number specifies the line of the token. The value `0`
+   *             means that the token computes its position lazily.
+   * @param charPositionInLine This number specifies the column of the token.
+   *
+   * @return A token with the specified parameters
+   */
+  unique_ptr<YAMLToken> create(pair<TokenSource *, CharStream *> source,
+                               size_t type, string const &text,
+                               size_t channel, size_t start, size_t stop,
+                               size_t line, size_t charPositionInLine) override;
+
+  /**
+   * @brief This method creates a new token that does not belong to any input.
+   *
+   * @param type This number specifies the type of the token.
+   * @param text This parameter stores the text of the token.
+   *
+   * @return A token with the specified parameters
+   */
+  unique_ptr<YAMLToken> create(size_t type, string const &text) override;
+
+  /**
+   * @brief This method releases the memory of all tokens created by the
+   *        factory.
+   *
+   * Call this method only after all tokens of the factory were destroyed.
+   */
+  void reset();
+
+  /**
+   * @brief This method releases the memory of the tokens stored in the other
+   *        arena and then creates all new tokens in this arena.
+   *
+   * Call this method only after all tokens the factory created before the
+   * last call of `rotate` were destroyed.
+   */
+  void rotate();
+};
+
+#endif // YAML_TOKEN_HPP
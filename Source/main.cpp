@@ -1,36 +1,78 @@
 // -- Imports ------------------------------------------------------------------
 
+#include <cerrno>
+#include <cstdlib>
 #include <fstream>
+#include <stdexcept>
+#include <system_error>
 
 #include <antlr4-runtime.h>
 #include <kdb.hpp>
 
-#include "YAML.h"
-
-#include "ErrorListener.hpp"
-#include "Listener.hpp"
-#include "YAMLLexer.hpp"
+#include "Batch.hpp"
+#include "ChunkParser.hpp"
+#include "DocumentParser.hpp"
+#include "InputBuffer.hpp"
+#include "Parser.hpp"
 
 using std::cerr;
 using std::cout;
 using std::endl;
 using std::ifstream;
-using std::stringstream;
+using std::istream;
+using std::runtime_error;
+using std::shared_ptr;
+using std::string;
+using std::strtoull;
+using std::system_error;
+using std::unique_ptr;
+using std::vector;
 
-using CppKey = kdb::Key;
 using ckdb::keyNew;
 
 using antlr4::ANTLRInputStream;
-using antlr4::CommonTokenStream;
-using ParseTree = antlr4::tree::ParseTree;
-using ParseTreeWalker = antlr4::tree::ParseTreeWalker;
-
-using antlr::YAML;
 
 // -- Functions ----------------------------------------------------------------
 
+/** This number specifies the number of keys the chunked mode prints at once. */
+size_t const BATCH_SIZE = 10000;
+
+/** This number specifies the largest value `--threads` accepts. */
+size_t const MAX_THREADS = 1024;
+
+/** This number specifies the largest value `--chunk-size` accepts. */
+size_t const MAX_CHUNK_SIZE = 1024 * 1024 * 1024;
+
+/**
+ * @brief This function converts the value of a numeric command line option.
+ *
+ * @param text This parameter stores the value of the option.
+ * @param minimum This number specifies the smallest value the option accepts.
+ * @param maximum This number specifies the largest value the option accepts.
+ * @param number This variable stores the value of `text`, if the function
+ *               succeeds. Otherwise the function does not modify it.
+ *
+ * @return `true`, if `text` only contains the decimal digits of a number
+ *         between `minimum` and `maximum`, or `false` otherwise
+ */
+bool parseNumber(string const &text, size_t const minimum,
+                 size_t const maximum, size_t &number) {
+  // `strtoull` skips leading white space and accepts a sign, which turns
+  // `-1` into the largest possible value
+  if (text.empty() || text[0] < '0' || text[0] > '9') {
+    return false;
+  }
+  char *end;
+  errno = 0;
+  unsigned long long const value = strtoull(text.c_str(), &end, 10);
+  if (errno == ERANGE || *end != '\0' || value < minimum || value > maximum) {
+    return false;
+  }
+  number = static_cast<size_t>(value);
+  return true;
+}
+
 void printTokens(CommonTokenStream &tokens) {
-  tokens.fill();
   cout << "— Tokens ——————" << endl << endl;
   for (auto token : tokens.getTokens()) {
     cout << token->toString() << endl;
@@ -43,49 +85,248 @@ void printTree(ParseTree *tree) {
   cout << tree->toStringTree() << endl << endl;
 }
 
-void printOutput(KeyListener &listener) {
-  cout << "— Output ————" << endl << endl;
-  for (auto key : listener.keySet()) {
+void printKeys(CppKeySet &keys) {
+  for (auto key : keys) {
     cout << key.getName() << ":"
          << (key.getStringSize() > 1 ? " " + key.getString() : "") << endl;
   }
 }
 
+void printOutput(CppKeySet &keys) {
+  cout << "— Output ————" << endl << endl;
+  printKeys(keys);
+}
+
+int printChunks(string const &filename, size_t const chunkSize,
+                bool const alwaysNest, shared_ptr<logger> console) {
+  ifstream file;
+  istream *stream = &std::cin;
+  if (filename != "-") {
+    file.open(filename, std::ios::binary);
+    if (!file) {
+      cerr << "Unable to open “" << filename << "”" << endl;
+      return EXIT_FAILURE;
+    }
+    stream = &file;
+  }
+
+  // We do not print the input, since it might not fit into memory
+  ChunkStream input{*stream, chunkSize, filename};
+  ChunkParser parser{BATCH_SIZE, console};
+  parser.setAlwaysNest(alwaysNest);
+  CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+  cout << "— Output ————" << endl << endl;
+  try {
+    parser.parse(&input, parent, printKeys);
+  } catch (runtime_error const &error) {
+    cerr << error.what() << endl
+         << "Use --nesting=always to store every document below #0, #1, …"
+         << endl;
+    return EXIT_FAILURE;
+  }
+  return static_cast<int>(parser.getNumberOfSyntaxErrors());
+}
+
+template <typename Input>
+int printResult(Parser<Input> const &parser, CppKeySet &keys) {
+  // The event parser neither buffers the token stream, nor builds a parse
+  // tree we could print
+  if (parser.getTokenStream()->size() > 0) {
+    printTokens(*parser.getTokenStream());
+  }
+  if (parser.getParseTree() != nullptr) {
+    printTree(parser.getParseTree());
+  }
+  printOutput(keys);
+  return static_cast<int>(parser.getNumberOfSyntaxErrors());
+}
+
 // -- Main ---------------------------------------------------------------------
 
 int main(int argc, char const *argv[]) {
+  vector<string> paths;
+  size_t threads = 0;
+  size_t chunkSize = 64 * 1024;
+  bool trace = false;
+  bool generic = false;
+  bool chunked = false;
+  bool events = false;
+  bool twoStage = true;
+  bool streaming = false;
+  bool parallel = false;
+  bool speculative = false;
+  bool pipelined = false;
+  bool alwaysNest = false;
+  bool invalid = false;
+
+  for (int argument = 1; argument < argc; argument++) {
+    if (string(argv[argument]) == "--trace") {
+      trace = true;
+    } else if (string(argv[argument]) == "--lexer=generic") {
+      generic = true;
+      chunked = false;
+    } else if (string(argv[argument]) == "--lexer=buffer") {
+      generic = false;
+      chunked = false;
+    } else if (string(argv[argument]) == "--lexer=chunked") {
+      generic = false;
+      chunked = true;
+    } else if (string(argv[argument]) == "--parser=antlr") {
+      events = false;
+    } else if (string(argv[argument]) == "--parser=event") {
+      events = true;
+    } else if (string(argv[argument]) == "--prediction=two-stage") {
+      twoStage = true;
+    } else if (string(argv[argument]) == "--prediction=ll") {
+      twoStage = false;
+    } else if (string(argv[argument]) == "--mode=tree") {
+      streaming = false;
+    } else if (string(argv[argument]) == "--mode=stream") {
+      streaming = true;
+    } else if (string(argv[argument]) == "--documents=serial") {
+      parallel = false;
+    } else if (string(argv[argument]) == "--documents=parallel") {
+      parallel = true;
+    } else if (string(argv[argument]) == "--speculation=none") {
+      speculative = false;
+    } else if (string(argv[argument]) == "--speculation=keys") {
+      speculative = true;
+    } else if (string(argv[argument]) == "--pipeline=none") {
+      pipelined = false;
+    } else if (string(argv[argument]) == "--pipeline=lexer") {
+      pipelined = true;
+    } else if (string(argv[argument]) == "--nesting=auto") {
+      alwaysNest = false;
+    } else if (string(argv[argument]) == "--nesting=always") {
+      alwaysNest = true;
+    } else if (string(argv[argument]).compare(0, 10, "--threads=") == 0) {
+      if (!parseNumber(string(argv[argument]).substr(10), 0, MAX_THREADS,
+                       threads)) {
+        cerr << "The number of threads has to be between 0 (one per core) "
+                "and "
+             << MAX_THREADS << endl;
+        invalid = true;
+      }
+    } else if (string(argv[argument]).compare(0, 13, "--chunk-size=") == 0) {
+      if (!parseNumber(string(argv[argument]).substr(13), 1, MAX_CHUNK_SIZE,
+                       chunkSize)) {
+        cerr << "The chunk size has to be between 1 and " << MAX_CHUNK_SIZE
+             << " bytes" << endl;
+        invalid = true;
+      }
+    } else {
+      paths.push_back(argv[argument]);
+    }
+  }
 
-  if (argc < 2) {
-    cerr << "Usage: " << argv[0] << " filename" << endl;
+  if (invalid || paths.empty()) {
+    cerr << "Usage: " << argv[0]
+         << " [--trace] [--lexer=buffer|generic|chunked] "
+            "[--parser=antlr|event] [--prediction=two-stage|ll] "
+            "[--mode=tree|stream] [--documents=serial|parallel] "
+            "[--speculation=none|keys] [--pipeline=none|lexer] "
+            "[--threads=number] [--chunk-size=bytes] "
+            "[--nesting=auto|always] filename|directory|-…"
+         << endl
+         << endl
+         << "The chunked lexer prints keys in batches of " << BATCH_SIZE
+         << ". It rejects a stream with multiple documents, if the first\n"
+            "document contains more keys than a batch, unless "
+            "--nesting=always stores every document\n"
+            "below #0, #1, …, even if the stream contains a single document."
+         << endl;
     return EXIT_FAILURE;
   }
 
-  ifstream file{argv[1]};
-  if (!file.is_open()) {
-    cerr << "Unable to open file “" << argv[1] << "”" << endl;
+  shared_ptr<logger> console;
+  if (trace) {
+#ifdef HAVE_TRACE
+    console = createTraceLogger();
+#else
+    cerr << "Trace messages are disabled in this build (LOG_LEVEL)" << endl;
+#endif
+  }
+
+  Strategy const strategy =
+      events ? Strategy::EVENT : streaming ? Strategy::STREAM : Strategy::TREE;
+  Prediction const prediction =
+      twoStage ? Prediction::TWO_STAGE : Prediction::LL;
+  Pipeline const pipeline = pipelined ? Pipeline::LEXER : Pipeline::NONE;
+
+  if (alwaysNest && !chunked) {
+    cerr << "Only the chunked lexer supports --nesting=always" << endl;
     return EXIT_FAILURE;
   }
 
-  stringstream text;
-  text << file.rdbuf();
-  cout << "— Input ———————" << endl << endl << text.str() << endl;
-  ANTLRInputStream input(text.str());
-  YAMLLexer lexer(&input);
-  CommonTokenStream tokens(&lexer);
-  printTokens(tokens);
+  // In batch mode we only print the keys of each file
+  if (paths.size() > 1 || isDirectory(paths.front())) {
+    if (generic || chunked || pipelined) {
+      cerr << "The generic lexer, the chunked lexer and the pipeline only "
+              "support a single file"
+           << endl;
+      return EXIT_FAILURE;
+    }
+    vector<string> filenames;
+    try {
+      filenames = listFiles(paths);
+    } catch (system_error const &error) {
+      cerr << error.what() << endl;
+      return EXIT_FAILURE;
+    }
+    size_t const failures = parseFiles(filenames, threads, strategy,
+                                       prediction, console, cout, cerr);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
 
-  YAML parser(&tokens);
-  ErrorListener errorListener{};
-  parser.removeErrorListeners();
-  parser.addErrorListener(&errorListener);
+  string const &filename = paths.front();
+  if (chunked) {
+    if (!events || parallel || speculative || pipelined) {
+      cerr << "The chunked lexer only supports the event parser without "
+              "parallel documents and pipeline"
+           << endl;
+      return EXIT_FAILURE;
+    }
+    return printChunks(filename, chunkSize, alwaysNest, console);
+  }
 
-  ParseTree *tree = parser.yaml();
-  printTree(tree);
+  unique_ptr<InputBuffer> content;
+  try {
+    content.reset(new InputBuffer{filename});
+  } catch (system_error const &error) {
+    cerr << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  cout << "— Input ———————" << endl << endl;
+  cout.write(content->begin(), content->size()) << endl;
 
-  ParseTreeWalker walker{};
-  KeyListener listener{keyNew("user", KEY_END, "", KEY_VALUE)};
-  walker.walk(&listener, tree);
-  printOutput(listener);
+  CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
 
-  return parser.getNumberOfSyntaxErrors();
+  if (generic) {
+    if (parallel || speculative) {
+      cerr << "The generic lexer does not support parallel documents" << endl;
+      return EXIT_FAILURE;
+    }
+    ANTLRInputStream input{content->begin(), content->size()};
+    Parser<CharStream> parser{strategy, prediction, console, pipeline};
+    CppKeySet keys = parser.parse(&input, parent);
+    return printResult(parser, keys);
+  }
+  BufferStream input{content->begin(), content->size(), filename};
+  if (parallel || speculative) {
+    if (pipelined) {
+      cerr << "The pipeline does not support parallel documents" << endl;
+      return EXIT_FAILURE;
+    }
+    // The document parser provides neither the tokens nor a parse tree of
+    // the whole input
+    DocumentParser parser{threads, strategy, prediction,
+                          speculative ? Speculation::KEYS : Speculation::NONE,
+                          console};
+    CppKeySet keys = parser.parse(&input, parent);
+    printOutput(keys);
+    return static_cast<int>(parser.getNumberOfSyntaxErrors());
+  }
+  Parser<BufferStream> parser{strategy, prediction, console, pipeline};
+  CppKeySet keys = parser.parse(&input, parent);
+  return printResult(parser, keys);
 }
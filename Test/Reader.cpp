@@ -0,0 +1,232 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../Source/EventReader.hpp"
+#include "../Source/InputBuffer.hpp"
+#include "../Source/YAMLLexer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::map;
+using std::string;
+using std::system_error;
+using std::vector;
+
+using antlr4::ParseCancellationException;
+
+// -- Constants ----------------------------------------------------------------
+
+/**
+ * This map stores the events the reader has to produce for some of the files
+ * in the folder `Input`. The program compares the events of a file, if the
+ * filename (without directory) is a key of this map.
+ */
+map<string, vector<string>> const EXPECTED = {
+    {"List>List, Map>Mixed Scalars.yaml",
+     {"STREAM_START", "DOCUMENT_START", "SEQUENCE_START", "MAPPING_START",
+      "KEY \"bla\"", "SCALAR blubb", "MAPPING_END", "SEQUENCE_START",
+      "SCALAR hello", "SEQUENCE_END", "SEQUENCE_END", "DOCUMENT_END",
+      "STREAM_END"}}};
+
+/** This variable specifies the value of `read` for a complete pass. */
+size_t const NO_SKIP = static_cast<size_t>(-1);
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function returns a textual representation of an event.
+ *
+ * @param event This parameter stores the event this function converts.
+ *
+ * @return The name of the event type, followed by the text of the scalar for
+ *         events of type `KEY` and `SCALAR`
+ */
+string describe(Event const &event) {
+  switch (event.type) {
+  case EventType::STREAM_START:
+    return "STREAM_START";
+  case EventType::STREAM_END:
+    return "STREAM_END";
+  case EventType::DOCUMENT_START:
+    return "DOCUMENT_START";
+  case EventType::DOCUMENT_END:
+    return "DOCUMENT_END";
+  case EventType::MAPPING_START:
+    return "MAPPING_START";
+  case EventType::MAPPING_END:
+    return "MAPPING_END";
+  case EventType::SEQUENCE_START:
+    return "SEQUENCE_START";
+  case EventType::SEQUENCE_END:
+    return "SEQUENCE_END";
+  case EventType::KEY:
+    return "KEY " + event.scalar.str();
+  case EventType::SCALAR:
+    return "SCALAR " + event.scalar.str();
+  }
+  return "<INVALID>";
+}
+
+/**
+ * @brief This function reads all events of the given file.
+ *
+ * @param content This parameter stores the content of the file.
+ * @param filename This parameter stores the name of the file.
+ * @param view This boolean specifies if the scalar events of the reader
+ *             should point into `content` or into the buffers of the reader.
+ * @param skipAt This number specifies the index of the event after which the
+ *               function calls `skip` once, or `NO_SKIP`.
+ *
+ * @return The textual representation of each event the reader returned
+ */
+vector<string> read(InputBuffer const &content, string const &filename,
+                    bool const view, size_t const skipAt) {
+  BufferStream input{content.begin(), content.size(), filename};
+  YAMLLexer<BufferStream> lexer{&input};
+  EventReader reader{&lexer, view ? content.begin() : nullptr};
+
+  vector<string> events;
+  Event event;
+  do {
+    event = reader.next();
+    events.push_back(describe(event));
+    if (events.size() - 1 == skipAt) {
+      reader.skip();
+    }
+  } while (event.type != EventType::STREAM_END);
+  return events;
+}
+
+/**
+ * @brief This function returns the events a reader has to return, if its
+ *        user calls `skip` after a certain event.
+ *
+ * @param events This parameter stores all events of the input.
+ * @param skipAt This number specifies the index of the event after which the
+ *               user calls `skip`.
+ *
+ * @return `events` without the content and end of the collection that starts
+ *         at `skipAt`, or `events` if this event does not start a collection
+ */
+vector<string> withoutCollection(vector<string> const &events,
+                                 size_t const skipAt) {
+  if (events[skipAt] != "MAPPING_START" &&
+      events[skipAt] != "SEQUENCE_START") {
+    return events;
+  }
+
+  size_t end = skipAt + 1;
+  for (size_t depth = 1; depth > 0; end++) {
+    if (events[end] == "MAPPING_START" || events[end] == "SEQUENCE_START") {
+      depth++;
+    } else if (events[end] == "MAPPING_END" ||
+               events[end] == "SEQUENCE_END") {
+      depth--;
+    }
+  }
+  vector<string> remaining{events.begin(), events.begin() + skipAt + 1};
+  remaining.insert(remaining.end(), events.begin() + end, events.end());
+  return remaining;
+}
+
+/**
+ * @brief This function prints the differences between two event sequences.
+ *
+ * @param actual This parameter stores the events the reader returned.
+ * @param expected This parameter stores the events the reader should have
+ *                 returned.
+ */
+void printDifference(vector<string> const &actual,
+                     vector<string> const &expected) {
+  for (size_t index = 0; index < actual.size() || index < expected.size();
+       index++) {
+    cerr << (index < actual.size() ? actual[index] : "—") << " | "
+         << (index < expected.size() ? expected[index] : "—") << endl;
+  }
+  cerr << endl;
+}
+
+/**
+ * @brief This function checks the events of the given file.
+ *
+ * @param content This parameter stores the content of the file.
+ * @param filename This parameter stores the name of the file.
+ * @param view This boolean specifies if the scalar events of the reader
+ *             should point into `content` or into the buffers of the reader.
+ *
+ * @return The number of checks that failed
+ */
+size_t check(InputBuffer const &content, string const &filename,
+             bool const view) {
+  string const mode = view ? "view" : "copy";
+  vector<string> const events = read(content, filename, view, NO_SKIP);
+  size_t failures = 0;
+
+  auto const expected = EXPECTED.find(filename.substr(filename.rfind('/') + 1));
+  if (expected != EXPECTED.end() && events != expected->second) {
+    cerr << "The events of “" << filename << "” (" << mode
+         << ") did not match the expected events:" << endl
+         << endl;
+    printDifference(events, expected->second);
+    failures++;
+  }
+
+  // After `MAPPING_START` and `SEQUENCE_START` the reader has to continue
+  // after the end of the collection (e.g. at the next key of the parent
+  // mapping). After every other event `skip` must not consume any events.
+  for (size_t skipAt = 0; skipAt < events.size(); skipAt++) {
+    vector<string> const skipped = read(content, filename, view, skipAt);
+    vector<string> const remaining = withoutCollection(events, skipAt);
+    if (skipped != remaining) {
+      cerr << "The events of “" << filename << "” (" << mode
+           << ") after skipping at " << events[skipAt] << " (event "
+           << skipAt << ") did not match the expected events:" << endl
+           << endl;
+      printDifference(skipped, remaining);
+      failures++;
+    }
+  }
+  return failures;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * This program reads the given files with `EventReader`, once with scalar
+ * events that point into the input buffer and once with copied scalars. It
+ * compares the events of the files in `EXPECTED` and calls `skip` after each
+ * event of every file. The program fails, if the reader returns unexpected
+ * events or rejects one of the files.
+ */
+int main(int argc, char const *argv[]) {
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " filename…" << endl;
+    return EXIT_FAILURE;
+  }
+
+  size_t failures = 0;
+  for (int argument = 1; argument < argc; argument++) {
+    string const filename{argv[argument]};
+    try {
+      InputBuffer const content{filename};
+      failures += check(content, filename, true) +
+                  check(content, filename, false);
+    } catch (system_error const &error) {
+      cerr << error.what() << endl;
+      return EXIT_FAILURE;
+    } catch (ParseCancellationException const &error) {
+      cerr << "Unable to read “" << filename << "”: " << error.what() << endl;
+      failures++;
+    }
+  }
+
+  cout << "Read " << argc - 1 << " files: " << failures << " failures"
+       << endl;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
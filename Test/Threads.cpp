@@ -0,0 +1,130 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <kdb.hpp>
+
+#include "../Source/InputBuffer.hpp"
+#include "../Source/Parser.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::stoul;
+using std::string;
+using std::system_error;
+using std::thread;
+using std::unique_ptr;
+using std::vector;
+
+using ckdb::keyNew;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function parses the given file with a parser session.
+ *
+ * @param parser This parameter stores the session that parses the file.
+ * @param content This parameter stores the content of the file.
+ * @param filename This parameter stores the name of the file.
+ *
+ * @return The names and values of all keys in the result, in the format of
+ *         the expected output files in the folder `Input`
+ */
+string parse(Parser<BufferStream> &parser, InputBuffer const &content,
+             string const &filename) {
+  BufferStream input{content.begin(), content.size(), filename};
+  CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+  CppKeySet keys = parser.parse(&input, parent);
+
+  string output;
+  for (auto key : keys) {
+    output += key.getName() + ":" +
+              (key.getStringSize() > 1 ? " " + key.getString() : "") + "\n";
+  }
+  return output;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * This program parses the given files on multiple threads at the same time.
+ * Each thread uses its own parser session, and parses all files multiple
+ * times. The threads alternate between the parse strategies, so the ANTLR
+ * parsers on different threads share the DFA cache of the grammar. Every
+ * second session also runs its lexer on a thread of its own. The program
+ * fails, if a thread produces a result that differs from the result of a
+ * single parser on the main thread.
+ */
+int main(int argc, char const *argv[]) {
+  size_t threads = 8;
+  size_t rounds = 10;
+  vector<string> filenames;
+
+  for (int argument = 1; argument < argc; argument++) {
+    string const option{argv[argument]};
+    if (option.compare(0, 10, "--threads=") == 0) {
+      threads = stoul(option.substr(10));
+    } else if (option.compare(0, 9, "--rounds=") == 0) {
+      rounds = stoul(option.substr(9));
+    } else {
+      filenames.push_back(option);
+    }
+  }
+
+  if (filenames.empty()) {
+    cerr << "Usage: " << argv[0] << " [--threads=number] [--rounds=number] "
+         << "filename…" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vector<unique_ptr<InputBuffer>> contents;
+  vector<string> expected;
+  Parser<BufferStream> reference;
+  for (auto const &filename : filenames) {
+    try {
+      contents.emplace_back(new InputBuffer{filename});
+    } catch (system_error const &error) {
+      cerr << error.what() << endl;
+      return EXIT_FAILURE;
+    }
+    expected.push_back(parse(reference, *contents.back(), filename));
+  }
+
+  // Each thread only writes its own counter
+  vector<size_t> failures(threads, 0);
+  vector<thread> workers;
+  for (size_t number = 0; number < threads; number++) {
+    workers.emplace_back([&, number]() {
+      Strategy const strategies[] = {Strategy::TREE, Strategy::STREAM,
+                                     Strategy::EVENT};
+      Pipeline const pipeline = number % 2 == 0 ? Pipeline::NONE
+                                                : Pipeline::LEXER;
+      Parser<BufferStream> parser{strategies[number % 3],
+                                  Prediction::TWO_STAGE, nullptr, pipeline};
+      for (size_t round = 0; round < rounds; round++) {
+        for (size_t file = 0; file < filenames.size(); file++) {
+          if (parse(parser, *contents[file], filenames[file]) !=
+              expected[file]) {
+            failures[number]++;
+          }
+        }
+      }
+    });
+  }
+
+  size_t mismatches = 0;
+  for (size_t number = 0; number < threads; number++) {
+    workers[number].join();
+    mismatches += failures[number];
+  }
+
+  cout << "Parsed " << filenames.size() << " files " << rounds
+       << " times on " << threads << " threads: " << mismatches
+       << " mismatches" << endl;
+  return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,10 +1,12 @@
 #!/usr/bin/env fish
 
 set parser "Build/badger"
+set strip_indices 's/^\[@([0-9]+),[0-9]+:[0-9]+=/[@\1,/'
 trap cleanup EXIT INT QUIT TERM
 
 function cleanup -d 'Remove temporary files'
-    rm -f "$output" "$difference"
+    rm -f "$output" "$difference" "$generic" "$buffer" "$events" "$batch" \
+        "$batch_expected" "$messages" "$large"
 end
 
 set IFS (printf '\n\b')
@@ -28,6 +30,159 @@ for file in (find Input -depth 1 -type file -name '*.yaml' | sort)
         cat "$difference" >&2
         set failed 'true'
     end
+
+    # The event parser, the streaming mode (parse listener without parse
+    # tree), the parallel document parser, the speculative split at top level
+    # keys, the lexer thread and the chunked input (with tiny chunks, so
+    # tokens and code points cross chunk boundaries) have to produce the same
+    # key set as the parse tree walker.
+    for variant in --parser=event --mode=stream --documents=parallel \
+        '--speculation=keys --threads=4' --pipeline=lexer \
+        '--pipeline=lexer --parser=event' \
+        '--lexer=chunked --parser=event --chunk-size=3'
+        set events (mktemp)
+        set -l error_message (eval $parser $variant "\"$file\"" 2>&1 >"$events")
+        if test "$status" -ne 0
+            printf "\nUnable to parse “%s” (%s):\n\n" "$file" "$variant" >&2
+            printf '%s\n\n' "$error_message" >&2
+            set failed 'true'
+            continue
+        end
+
+        perl -0777pe 's/.*— Output ————\n\n(.*)/\1/sm' -i "$events"
+        if ! diff --side-by-side "$events" "$expected" >"$difference"
+            printf "\nThe output for “%s” (%s) did not match the expected output:\n\n" "$file" "$variant" >&2
+            cat "$difference" >&2
+            set failed 'true'
+        end
+    end
+
+    # The lexer for UTF-8 buffers has to produce the same tokens (including
+    # line and column numbers) as the generic lexer. We only ignore the start
+    # and stop index of tokens, since the buffer lexer uses byte offsets,
+    # while the generic lexer uses code point offsets.
+    set generic (mktemp)
+    eval $parser --lexer=generic "\"$file\"" 2>&1 | sed -E "$strip_indices" >"$generic"
+    set -l generic_status $pipestatus[1]
+    set buffer (mktemp)
+    eval $parser --lexer=buffer "\"$file\"" 2>&1 | sed -E "$strip_indices" >"$buffer"
+    set -l buffer_status $pipestatus[1]
+    if test "$generic_status" -ne 0 -o "$buffer_status" -ne 0
+        printf "\nUnable to lex “%s” (generic: %s, buffer: %s):\n\n" "$file" \
+            "$generic_status" "$buffer_status" >&2
+        cat "$generic" "$buffer" >&2
+        set failed 'true'
+    else if ! diff --side-by-side "$generic" "$buffer" >"$difference"
+        printf "\nThe generic and the buffer lexer disagree on “%s”:\n\n" "$file" >&2
+        cat "$difference" >&2
+        set failed 'true'
+    end
+end
+
+# Every mode has to report an input the lexer is unable to tokenize with the
+# same message (line, column and description of the error), exit with status
+# 1 and print no keys. The folder `Test/Errors` stores these inputs and the
+# expected error messages.
+for file in (find Test/Errors -depth 1 -type file -name '*.yaml' | sort)
+    printf "• Test error file “%s”\n" "$file"
+    set -l expected (printf "$file" | sed 's/\.[^.]*$/.txt/')
+    for variant in '' --parser=event --mode=stream --documents=parallel \
+        '--speculation=keys --threads=4' --pipeline=lexer \
+        '--pipeline=lexer --parser=event' --lexer=generic \
+        '--lexer=chunked --parser=event --chunk-size=3'
+        set output (mktemp)
+        set messages (mktemp)
+        eval $parser $variant "\"$file\"" 2>"$messages" >"$output"
+        set -l exit_status $status
+        perl -0777pe 's/.*— Output ————\n\n(.*)/\1/sm' -i "$output"
+        set difference (mktemp)
+        if test "$exit_status" -ne 1
+            printf "\nThe exit status for “%s” (%s) was %s instead of 1\n\n" \
+                "$file" "$variant" "$exit_status" >&2
+            cat "$messages" >&2
+            set failed 'true'
+        else if test -s "$output"
+            printf "\nThe parser returned keys for “%s” (%s):\n\n" "$file" \
+                "$variant" >&2
+            cat "$output" >&2
+            set failed 'true'
+        else if ! diff --side-by-side "$messages" "$expected" >"$difference"
+            printf "\nThe error message for “%s” (%s) did not match the expected message:\n\n" "$file" "$variant" >&2
+            cat "$difference" >&2
+            set failed 'true'
+        end
+    end
+end
+
+# The chunked lexer passes the keys on in batches of 10 000 keys. It is only
+# able to move the keys of the first document below `#0`, if it did not pass
+# them on yet. It therefore has to reject a stream with a larger first
+# document, unless `--nesting=always` stores every document below its array
+# base name from the start. In this mode it has to produce the same keys as
+# the event parser, apart from the order of the batches.
+printf "• Test chunked input with a large first document\n"
+set large (mktemp)
+begin
+    seq 0 10000 | sed 's/.*/key&: value/'
+    printf -- '---\nsecond\n'
+end >"$large"
+set output (mktemp)
+set events (mktemp)
+set difference (mktemp)
+if eval $parser --lexer=chunked --parser=event "\"$large\"" >/dev/null 2>&1
+    printf "\nThe chunked lexer accepted a large first document without --nesting=always\n\n" >&2
+    set failed 'true'
+else if ! eval $parser --lexer=chunked --parser=event --nesting=always \
+        "\"$large\"" >"$output"
+    printf "\nUnable to parse a large first document with --nesting=always\n\n" >&2
+    set failed 'true'
+else
+    eval $parser --parser=event "\"$large\"" >"$events"
+    perl -0777pe 's/.*— Output ————\n\n(.*)/\1/sm' -i "$output" "$events"
+    if ! diff --side-by-side (sort -u "$output" | psub) (sort -u "$events" | psub) \
+            >"$difference"
+        printf "\nThe keys of the chunked lexer (--nesting=always) did not match the keys of the event parser:\n\n" >&2
+        cat "$difference" >&2
+        set failed 'true'
+    end
+end
+
+# The command line tool has to reject invalid numbers with the usage text and
+# status 1, instead of terminating with an uncaught exception, wrapping a
+# negative number around or replacing a chunk size of 0 with 1.
+printf "• Test invalid option values\n"
+for option in '--documents=parallel --threads='{abc,-1,+4,1025} \
+    '--documents=parallel --threads=99999999999999999999999' \
+    '--lexer=chunked --parser=event --chunk-size='{abc,-1,0,1073741825}
+    eval $parser $option Input/Null.yaml >/dev/null 2>&1
+    set -l exit_status $status
+    if test "$exit_status" -ne 1
+        printf "\nThe exit status for “%s” was %s instead of 1\n\n" "$option" \
+            "$exit_status" >&2
+        set failed 'true'
+    end
+end
+
+# Batch mode parses all files of a directory on multiple threads. It has to
+# print the keys of the files sorted by filename, independent of the order in
+# which the worker threads finish.
+printf "• Test batch mode\n"
+set batch_expected (mktemp)
+for file in (find Input -depth 1 -type file -name '*.yaml' | env LC_ALL=C sort)
+    printf '— %s ————\n\n' "$file"
+    cat (printf "$file" | sed 's/\.[^.]*$/.txt/')
+    printf '\n'
+end >"$batch_expected"
+
+set batch (mktemp)
+set difference (mktemp)
+if ! eval $parser --threads=4 Input >"$batch"
+    printf "\nUnable to parse the files in “Input” in batch mode\n\n" >&2
+    set failed 'true'
+else if ! diff --side-by-side "$batch" "$batch_expected" >"$difference"
+    printf "\nThe output of batch mode did not match the expected output:\n\n" >&2
+    cat "$difference" >&2
+    set failed 'true'
 end
 
 if test "$failed" = 'true'